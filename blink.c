@@ -1,15 +1,38 @@
 #include "pico/stdlib.h"
 #include "hardware/gpio.h"
-#include "hardware/pwm.h"
 #include "hardware/adc.h"
 #include "hardware/i2c.h"
 #include "hardware/pio.h"
 #include "hardware/timer.h"
-#include "ws2812.pio.h"
+#include "hardware/flash.h"
 #include "inc/ssd1306.h"
 #include "inc/font.h"
+#include "inc/event_queue.h"
+#include "inc/game_snapshot.h"
+#include "inc/adc_capture.h"
+#include "inc/mic_dsp.h"
+#include "inc/ws2812.h"
+#include "inc/audio.h"
+#include "inc/game.h"
+#include "inc/game_render.h"
+#include "inc/hal.h"
+#include "inc/profile.h"
+#include "inc/render_sched.h"
+#include "inc/input_trace.h"
+#include "inc/fb_mirror.h"
+#include "inc/screen_fx.h"
+#include "inc/timer_wheel.h"
+#include "inc/buttons.h"
+#include "inc/joystick.h"
+#include "inc/flash_log.h"
+#include "pico/critical_section.h"
+#include "pico/multicore.h"
+#include "pico/stdio_usb.h"
+#include "pico/util/queue.h"
+#include "tusb.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 // Definições de pinos
 #define LED_MATRIX_PIN 7
@@ -29,215 +52,532 @@
 #define LED_G 11
 #define LED_B 12
 
-// Tamanho do display
-#define WIDTH 128
-#define HEIGHT 64
-
-// Variáveis do jogo
-uint8_t cursor_x = 64;
-uint8_t cursor_y = 32;
-uint8_t target_x = 64;
-uint8_t target_y = 32;
-uint8_t score = 0;
-uint8_t click_count = 0;
-bool playing = true;
-bool paused = false;
-bool game_over = false;
-bool victory = false;
-
-// Variáveis para debounce
-volatile uint64_t joystick_last_press_time = 0;
-const uint32_t DEBOUNCE_DELAY_MS = 100;
+// Período do tick de entrada (joystick, microfone e teste de acerto)
+#define INPUT_TICK_US 1000
+
+// Taxa total do ADC em round robin (joystick Y, joystick X e microfone)
+#define ADC_SAMPLE_RATE 30000
+
+// Buffer do trace de entradas (joystick, botões, palmas e alvos sorteados)
+#ifndef INPUT_TRACE_SIZE
+#define INPUT_TRACE_SIZE 32768
+#endif
+
+// Intervalo entre passos do codificador do espelho do display
+#define MIRROR_STEP_US 1000
+
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
+
+// 1: core1 renderiza display, matriz de LEDs e áudio a partir de snapshots
+// 0: tudo roda no core0, logo após o processamento dos eventos
+#ifndef MULTICORE_RENDER
+#define MULTICORE_RENDER 1
+#endif
+
+// Estado do jogo (acessado apenas pelo loop principal no core0)
+game_t game;
+
+// Botões com debounce no PIO, na ordem dos eventos de button_types
+#define BUTTON_DEBOUNCE_US 10000  // Tempo que o nível precisa ficar estável
+const uint button_pins[] = {BUTTON_A, BUTTON_B, JOYSTICK_BTN};
+const event_type_t button_types[] = {EVENT_BUTTON_A, EVENT_BUTTON_B, EVENT_JOYSTICK_CLICK};
 
 ssd1306_t ssd;
 
+// Escalonamento dos quadros (core de renderização)
+render_sched_t render_sched;
+game_snapshot_t frame_snap;  // Snapshot mais recente a desenhar
+game_view_t game_view;       // HUD retido: só o que mudou é redesenhado
+screen_fx_t screen_fx;       // Efeitos da tela final feitos pelo display
+
+// Taxa efetiva do tick de entrada (core0)
+rate_counter_t input_rate;
+
+// Espelho do display pela USB (core de renderização; 'm' liga e desliga)
+fb_mirror_t mirror;
+volatile bool mirror_enabled = false;
+uint32_t mirrored_frames = 0;
+
+// Pacotes do espelho a caminho da USB: o core de renderização enfileira e o
+// core0 escreve, como todo o resto da saída USB
+#define MIRROR_QUEUE_PACKETS 8  // Um quadro inteiro em pacotes de FB_MIRROR_STEP bytes
+typedef struct {
+  uint16_t len;
+  uint8_t data[FB_MIRROR_MAX_PACKET];
+} mirror_packet_t;
+queue_t mirror_queue;
+
+// Gravação das entradas para replay (core0)
+static uint8_t trace_buffer[INPUT_TRACE_SIZE];
+input_trace_t trace;
+
+// Joystick calibrado e filtrado (core0); 'c' calibra os extremos
+#define JOYSTICK_CALIBRATION_US 3000000  // Tempo para girar o joystick até o fim
+joystick_t joystick;
+uint32_t joystick_calibration_end_us;
+
+// Log persistente nos últimos setores da flash (core0): estatísticas,
+// recorde, última partida e calibração do joystick. As versões novas ficam
+// em RAM e só são gravadas com a tela final parada, um pouco depois do fim
+// da partida; o core1 fica estacionado em RAM durante a gravação.
+#define FLASH_LOG_SECTORS 8
+#define FLASH_LOG_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_LOG_SECTORS * HAL_FLASH_SECTOR_SIZE)
+#define FLASH_COMMIT_DELAY_MS 500  // Tela final já entregue ao display
+
+enum {
+  FLASH_REC_STATS,      // saved_stats_t
+  FLASH_REC_LAST_GAME,  // last_game_t
+  FLASH_REC_JOYSTICK    // joystick_axis_cal_t[2]: extremos calibrados
+};
+
+typedef struct {
+  uint32_t games, wins, losses;
+  uint32_t hits;
+  uint32_t best_win_ms;  // Vitória mais rápida; 0 = nenhuma
+} saved_stats_t;
+
+typedef struct {
+  uint32_t duration_ms;
+  uint8_t score;
+  uint8_t click_count;
+  bool victory;
+} last_game_t;
+
+flash_log_t flash_log;
+saved_stats_t saved_stats;
+uint32_t game_start_us;  // Início da partida atual
+timer_wheel_timer_t flash_timer;
+
+// Estado do front-end do microfone
+mic_dsp_t mic_dsp;
+uint32_t mic_cursor = 0;
+uint16_t mic_block[MIC_DSP_BLOCK];
+uint32_t mic_block_fill = 0;
+
 // Variáveis para temporizadores e interrupções
-volatile bool button_a_pressed = false;
-volatile bool button_b_pressed = false;
-volatile bool joystick_btn_pressed = false;
-volatile bool sound_active = false;
 volatile int led_blink_count = 0;
 volatile bool led_state = false;
-struct repeating_timer game_timer;
-struct repeating_timer *blink_timer_ptr = NULL;
+volatile bool blink_victory = false;
+
+// Roda de temporizadores: um alarme de hardware por tick avança todos os
+// prazos (tick de entrada, reinício, gravação da flash e LED piscando). É usada
+// pelas IRQs e pelos dois cores, sempre com o lock.
+timer_wheel_t timers;
+critical_section_t timers_lock;
+timer_wheel_timer_t input_tick_timer;
+timer_wheel_timer_t reset_timer;
+timer_wheel_timer_t blink_timer;
+
+_Static_assert(INPUT_TICK_US % TIMER_WHEEL_TICK_US == 0, "tick de entrada fora da resolução da roda");
 
 // Protótipos de funções
 void init_peripherals(void);
 void read_joystick(void);
 bool detect_loud_sound(void);
 void play_sound(uint buzzer, uint freq);
-int64_t stop_sound(alarm_id_t id, void *user_data);
 void update_led_matrix(uint8_t progress);
 void set_rgb_led(uint8_t r, uint8_t g, uint8_t b);
 void show_victory_screen(void);
 void show_game_over_screen(void);
-void reset_game(void);
 void update_display(void);
-void maintain_final_screen(void);
+void update_screen_fx(void);
+void render_snapshot(const game_snapshot_t *snap);
+void game_loop(void);
+void handle_click(void);
+
+// Alarme de hardware da roda: processa os ticks vencidos e agenda o
+// próximo; se o alvo já passou enquanto os callbacks rodavam, repete
+void timers_alarm_callback(uint alarm_num) {
+    uint64_t tick;
+    do {
+        tick = time_us_64() / TIMER_WHEEL_TICK_US;
+        critical_section_enter_blocking(&timers_lock);
+        timer_wheel_advance(&timers, (uint32_t)tick);
+        critical_section_exit(&timers_lock);
+    } while (hardware_alarm_set_target(alarm_num, from_us_since_boot((tick + 1) * TIMER_WHEEL_TICK_US)));
+}
 
-// Callbacks de debounce
-int64_t button_a_debounce_callback(alarm_id_t id, void *user_data) {
-    button_a_pressed = false;
-    paused = !paused;
-    return 0;
+void timers_init(void) {
+    critical_section_init(&timers_lock);
+    timer_wheel_init(&timers, (uint32_t)(time_us_64() / TIMER_WHEEL_TICK_US));
+    int alarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(alarm, timers_alarm_callback);
+    timers_alarm_callback(alarm);
 }
 
-int64_t button_b_debounce_callback(alarm_id_t id, void *user_data) {
-    button_b_pressed = false;
-    reset_game();
-    return 0;
+// Fora dos callbacks da roda: eles já rodam com o timers_lock, que não é
+// recursivo, e usam timer_wheel_start/timer_wheel_cancel direto
+void timers_start(timer_wheel_timer_t *timer, uint32_t delay_ticks, uint32_t period_ticks,
+                  timer_wheel_callback_t callback) {
+    critical_section_enter_blocking(&timers_lock);
+    timer_wheel_start(&timers, timer, delay_ticks, period_ticks, callback, NULL);
+    critical_section_exit(&timers_lock);
 }
 
-int64_t joystick_btn_debounce_callback(alarm_id_t id, void *user_data) {
-    joystick_btn_pressed = false;
-    gpio_set_irq_enabled(JOYSTICK_BTN, GPIO_IRQ_EDGE_FALL, true);
-    return 0;
+void timers_cancel(timer_wheel_timer_t *timer) {
+    critical_section_enter_blocking(&timers_lock);
+    timer_wheel_cancel(&timers, timer);
+    critical_section_exit(&timers_lock);
 }
 
-int64_t reset_game_callback(alarm_id_t id, void *user_data) {
-    reset_game();
-    return 0;
+// As rotinas de interrupção apenas enfileiram eventos; o estado do jogo é
+// alterado somente pelo loop principal
+bool reset_game_callback(timer_wheel_timer_t *timer, void *user_data) {
+    event_queue_push(EVENT_GAME_RESET);
+    return false;
 }
 
-// Handler de interrupções
-void button_handler(uint gpio, uint32_t events) {
-    if (gpio == BUTTON_A && events & GPIO_IRQ_EDGE_FALL && !button_a_pressed) {
-        button_a_pressed = true;
-        add_alarm_in_ms(200, button_a_debounce_callback, NULL, false);
-    }
-    if (gpio == BUTTON_B && events & GPIO_IRQ_EDGE_FALL && !button_b_pressed) {
-        button_b_pressed = true;
-        add_alarm_in_ms(200, button_b_debounce_callback, NULL, false);
-    }
-    if (gpio == JOYSTICK_BTN && events & GPIO_IRQ_EDGE_FALL) {
-        uint64_t now = time_us_64();
-        if ((now - joystick_last_press_time) > (DEBOUNCE_DELAY_MS * 1000)) {
-            joystick_btn_pressed = true;
-            joystick_last_press_time = now;
-            gpio_set_irq_enabled(JOYSTICK_BTN, GPIO_IRQ_EDGE_FALL, false);
-            add_alarm_in_ms(DEBOUNCE_DELAY_MS, joystick_btn_debounce_callback, NULL, false);
+bool flash_commit_callback(timer_wheel_timer_t *timer, void *user_data) {
+    event_queue_push(EVENT_FLASH_COMMIT);
+    return false;
+}
+
+// Tick de entrada: apenas sinaliza o loop principal
+bool input_tick_callback(timer_wheel_timer_t *timer, void *user_data) {
+    event_queue_push(EVENT_TICK);
+    return true;
+}
+
+// Botões: o PIO já entregou uma troca de estado limpa; o aperto vira evento
+// com o instante da borda
+void button_event_callback(const button_event_t *event) {
+    if (event->pressed)
+        event_queue_push_at(button_types[event->index], event->edge_us);
+}
+
+// Tick do jogo, executado no loop principal
+void game_loop(void) {
+    rate_counter_add(&input_rate, time_us_32());
+
+    // O microfone é processado sempre, para o piso de ruído seguir o ambiente
+    bool clap = detect_loud_sound();
+
+    // O filtro do joystick também, para não começar atrasado ao sair da pausa
+    read_joystick();
+
+    if (game_accepts_input(&game)) {
+        if (clap) {  // Palma conta como clique do joystick
+            input_trace_event(&trace, TRACE_CLAP, time_us_32());
+            handle_click();
         }
     }
 }
 
-// Loop principal do jogo
-bool game_loop(struct repeating_timer *t) {
-    if (game_over) {
-        maintain_final_screen();
-        return true;
+// Fim da partida: atualiza os registros persistentes (só em RAM por ora)
+void record_game_end(void) {
+    last_game_t last = {
+        .duration_ms = (time_us_32() - game_start_us) / 1000,
+        .score = game.score,
+        .click_count = game.click_count,
+        .victory = game.victory,
+    };
+    saved_stats.games++;
+    saved_stats.hits += game.score;
+    if (game.victory) {
+        saved_stats.wins++;
+        if (saved_stats.best_win_ms == 0 || last.duration_ms < saved_stats.best_win_ms)
+            saved_stats.best_win_ms = last.duration_ms;
+    } else {
+        saved_stats.losses++;
     }
+    flash_log_put(&flash_log, FLASH_REC_STATS, &saved_stats, sizeof(saved_stats));
+    flash_log_put(&flash_log, FLASH_REC_LAST_GAME, &last, sizeof(last));
+}
 
-    if (playing && !paused) {
-        read_joystick();
+// Clique do joystick: ao fim da partida agenda o reinício e a gravação
+void handle_click(void) {
+    if (game_click(&game)) {
+        record_game_end();
+        timers_start(&reset_timer, TIMER_WHEEL_MS(GAME_RESET_DELAY_MS), 0, reset_game_callback);
+        timers_start(&flash_timer, TIMER_WHEEL_MS(FLASH_COMMIT_DELAY_MS), 0, flash_commit_callback);
+    }
+}
 
-        if (joystick_btn_pressed) {
-            click_count++;
-            joystick_btn_pressed = false;
+// Grava o alvo sorteado por um acerto ou reinício
+void trace_new_target(uint32_t hits_before, uint32_t resets_before) {
+    if (game.hit_count != hits_before || game.reset_count != resets_before)
+        input_trace_target(&trace, time_us_32(), game.target_x, game.target_y);
+}
 
-            if (abs(cursor_x - target_x) < 3 && abs(cursor_y - target_y) < 3) {
-                score++;
-                play_sound(BUZZER1, 2000);
-                target_x = (rand() % (WIDTH - 4)) + 2;
-                target_y = (rand() % (HEIGHT - 4)) + 2;
-                click_count = 0;
-                update_led_matrix(score);
+// Despacha um evento retirado da fila
+void handle_event(const event_t *event) {
+    uint32_t hits = game.hit_count;
+    uint32_t resets = game.reset_count;
+
+    switch (event->type) {
+        case EVENT_TICK:
+            // Tick atendido mais de um período depois de gerado
+            if (time_us_32() - event->timestamp_us > INPUT_TICK_US)
+                PROFILE_OVERRUN();
+            game_loop();
+            break;
+        case EVENT_BUTTON_A:
+            input_trace_event(&trace, TRACE_BUTTON_A, event->timestamp_us);
+            game_toggle_pause(&game);
+            break;
+        case EVENT_BUTTON_B:
+            input_trace_event(&trace, TRACE_BUTTON_B, event->timestamp_us);
+            timers_cancel(&reset_timer);  // Reinício manual antes do automático
+            game_reset(&game);
+            break;
+        case EVENT_GAME_RESET:
+            input_trace_event(&trace, TRACE_RESET, time_us_32());
+            game_reset(&game);
+            break;
+        case EVENT_JOYSTICK_CLICK:
+            input_trace_event(&trace, TRACE_CLICK, event->timestamp_us);
+            handle_click();
+            break;
+        case EVENT_FLASH_COMMIT:
+            // Só com a tela final ainda no display; senão fica para a próxima.
+            // Cada commit só grava ou só apaga: o que sobrar vai num commit
+            // seguinte, ainda na tela final
+            if (game.game_over && flash_log_pending(&flash_log)) {
+                flash_log_commit(&flash_log);
+                if (flash_log_pending(&flash_log))
+                    timers_start(&flash_timer, TIMER_WHEEL_MS(FLASH_COMMIT_DELAY_MS), 0, flash_commit_callback);
             }
-        }
+            break;
+    }
+    trace_new_target(hits, resets);
+    if (game.reset_count != resets)
+        game_start_us = time_us_32();
+}
 
-        if (click_count > 10) {
-            game_over = true;
-            victory = false;
-            show_game_over_screen();
-            add_alarm_in_ms(5000, reset_game_callback, NULL, false);
-        }
+// Reinicia a gravação a partir de um estado conhecido: a partida recomeça
+void trace_restart(void) {
+    uint32_t now = time_us_32();
+    input_trace_start(&trace, now);
+    input_trace_event(&trace, TRACE_RESET, now);
+    game_reset(&game);
+    input_trace_target(&trace, now, game.target_x, game.target_y);
+    game_start_us = now;
+}
 
-        if (score >= 25) {
-            update_led_matrix(25);
-            game_over = true;
-            victory = true;
-            show_victory_screen();
-            add_alarm_in_ms(5000, reset_game_callback, NULL, false);
-        }
+// Aplica um snapshot: matriz de LEDs, LED RGB e áudio na hora, display
+// quando o escalonador liberar o próximo quadro. Compara com o último
+// snapshot recebido para disparar os efeitos de transição (acerto, fim de
+// jogo, reinício) apenas uma vez.
+void render_snapshot(const game_snapshot_t *snap) {
+    static game_snapshot_t last;
 
-        update_display();
+    if (snap->resets != last.resets) {
+        update_led_matrix(0);
+        timers_cancel(&blink_timer);
+    }
+    if (snap->hits != last.hits) {
+        play_sound(BUZZER1, 2000);
+        update_led_matrix(snap->score);
+    }
+
+    // Pausado, a tela fica congelada no último quadro
+    frame_snap = *snap;
+    if ((snap->game_over || (snap->playing && !snap->paused)) && !game_snapshot_equal(snap, &last))
+        render_sched_mark_dirty(&render_sched);
+
+    if (snap->game_over) {
+        if (!last.game_over) {
+            if (snap->victory)
+                show_victory_screen();
+            else
+                show_game_over_screen();
+        }
+    } else if (snap->playing && !snap->paused) {
         set_rgb_led(0, 1, 0);
-    } else if (paused) {
+    } else if (snap->paused) {
         set_rgb_led(1, 1, 0);
     } else {
         set_rgb_led(1, 0, 0);
     }
 
-    return true;
+    // Envia um quadro da matriz que ficou pendente com o driver ocupado
+    ws2812_show();
+
+    last = *snap;
 }
 
-// Função de atualização do display
-void update_display(void) {
-    ssd1306_fill(&ssd, false);
-    
-    // Desenha score
-    char score_str[4];
-    snprintf(score_str, sizeof(score_str), "%d", score);
-    ssd1306_draw_string(&ssd, "Score:", 0, 0);
-    int x_pos = 48;
-    for (int i = 0; score_str[i] != '\0'; i++) {
-        ssd1306_draw_char(&ssd, score_str[i], x_pos, 0);
-        x_pos += 8;
+// Saída do espelho (core de renderização): só enfileira o pacote; com a fila
+// cheia, ele espera o próximo passo
+bool mirror_write(const uint8_t *data, size_t len, void *user_data) {
+    mirror_packet_t packet;
+    packet.len = len;
+    memcpy(packet.data, data, len);
+    return queue_try_add(&mirror_queue, &packet);
+}
+
+// Core0: um pacote inteiro de uma vez no driver USB, para o texto do console
+// não cair no meio dele. As outras escritas na USB também saem do core0 fora
+// de interrupção, então o espaço conferido não diminui até a escrita.
+void mirror_drain(void) {
+    mirror_packet_t packet;
+    while (queue_try_peek(&mirror_queue, &packet)) {
+        if (!stdio_usb_connected() || tud_cdc_write_available() < packet.len) return;
+        stdio_usb.out_chars((const char *)packet.data, packet.len);
+        queue_try_remove(&mirror_queue, &packet);
     }
+}
 
-    // Desenha contagem de cliques
-    char click_str[4];
-    snprintf(click_str, sizeof(click_str), "%d", click_count);
-    x_pos = 0;
-    for (int i = 0; click_str[i] != '\0'; i++) {
-        ssd1306_draw_char(&ssd, click_str[i], x_pos, 12);
-        x_pos += 8;
+// Um passo do espelho; um quadro novo começa quando o anterior terminou de
+// sair e o display recebeu algo desde então
+void mirror_poll(void) {
+    static bool was_enabled = false;
+    if (!mirror_enabled) {
+        was_enabled = false;
+        return;
+    }
+    if (!was_enabled) {
+        fb_mirror_request_keyframe(&mirror);
+        mirrored_frames = render_sched.frames - 1;
+        was_enabled = true;
     }
+    if (!fb_mirror_busy(&mirror) && mirrored_frames != render_sched.frames) {
+        mirrored_frames = render_sched.frames;
+        fb_mirror_begin(&mirror, ssd.front_buffer);
+    }
+    fb_mirror_step(&mirror);
+}
 
-    // Desenha cursor
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            int x = cursor_x + dx;
-            int y = cursor_y + dy;
-            if (x >= 1 && x < WIDTH-1 && y >= 1 && y < HEIGHT-1) {
-                ssd1306_pixel(&ssd, x, y, true);
-            }
-        }
+// Fim do envio do quadro (último byte entregue ao FIFO do I2C)
+void flush_done_callback(ssd1306_t *display, void *user_data) {
+    PROFILE_STOP(PROFILE_BUS);
+    render_sched_flush_done(&render_sched, time_us_32());
+}
+
+// Preparação do core que renderiza: a IRQ de fim de flush é atendida nele
+void render_core_init(void) {
+    PROFILE_INIT_CORE();
+    render_sched_init(&render_sched, RENDER_SCHED_MIN_INTERVAL_US, time_us_32());
+    game_view_init(&game_view);
+    screen_fx_init(&screen_fx);
+    ssd1306_set_flush_callback(&ssd, flush_done_callback, NULL);
+    fb_mirror_init(&mirror, mirror_write, NULL);
+}
+
+// Dorme até o próximo evento; com um quadro pendente, no máximo até ele vencer.
+// O fim do flush (IRQ) e um snapshot novo (FIFO) também acordam o core.
+void render_wait(void) {
+    uint32_t timeout_us = 0;  // Sem prazo
+    if (render_sched.pending && !ssd1306_flush_busy(&ssd)) {
+        uint32_t elapsed = time_us_32() - render_sched.last_frame_us;
+        uint32_t interval = render_sched_interval(&render_sched);
+        if (elapsed >= interval) return;
+        timeout_us = interval - elapsed;
+    }
+    // Próximo passo do efeito da tela final
+    uint32_t fx_deadline;
+    if (screen_fx_next(&screen_fx, &fx_deadline)) {
+        int32_t fx_wait = (int32_t)(fx_deadline - time_us_32());
+        if (fx_wait <= 0) return;
+        if (timeout_us == 0 || (uint32_t)fx_wait < timeout_us)
+            timeout_us = fx_wait;
     }
+    // Quadro do espelho em codificação: o próximo passo vem no máximo em 1 ms
+    if (mirror_enabled && fb_mirror_busy(&mirror) && (timeout_us == 0 || timeout_us > MIRROR_STEP_US))
+        timeout_us = MIRROR_STEP_US;
+
+    if (timeout_us)
+        best_effort_wfe_or_timeout(make_timeout_time_us(timeout_us));
+    else
+        __wfe();
+}
 
-    // Desenha alvo
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            int x = target_x + dx;
-            int y = target_y + dy;
-            if (x >= 1 && x < WIDTH-1 && y >= 1 && y < HEIGHT-1) {
-                ssd1306_pixel(&ssd, x, y, true);
-            }
-        }
+// Core1: aplica os snapshots publicados pelo core0 e desenha no ritmo do display
+void core1_entry(void) {
+    game_snapshot_t snap;
+    render_core_init();
+    hal_flash_park_enable();
+    while (1) {
+        // Entre quadros: se o core0 vai gravar a flash, espera em RAM
+        hal_flash_park_point();
+        if (game_snapshot_poll(&snap))
+            render_snapshot(&snap);
+        update_screen_fx();
+        update_display();
+        mirror_poll();
+        render_wait();
     }
+}
 
-    ssd1306_send_data(&ssd);
+// Tela final: depois de entregue ao display, só recebe comandos de efeito.
+// Ao sair dela o efeito é desfeito antes do próximo quadro ser desenhado.
+void update_screen_fx(void) {
+    uint32_t now = time_us_32();
+    if (!frame_snap.game_over) {
+        if (screen_fx_active(&screen_fx))
+            screen_fx_stop(&screen_fx, &ssd);
+        return;
+    }
+    if (render_sched.pending || ssd1306_flush_busy(&ssd)) return;
+
+    if (!screen_fx_active(&screen_fx))
+        screen_fx_start(&screen_fx, &ssd, frame_snap.victory ? SCREEN_FX_VICTORY : SCREEN_FX_GAME_OVER, now);
+    else
+        screen_fx_poll(&screen_fx, &ssd, now);
 }
 
-// Mantém tela final
-void maintain_final_screen(void) {
-    if (victory) {
-        ssd1306_fill(&ssd, false);
-        ssd1306_draw_string(&ssd, "PARABENS!", 20, 20);
-        ssd1306_draw_string(&ssd, "Score: 25", 30, 35);
-        ssd1306_draw_string(&ssd, "VOCE COMPLETOU!", 5, 50);
-        ssd1306_send_data(&ssd);
-    } else {
-        ssd1306_fill(&ssd, false);
-        ssd1306_draw_string(&ssd, "GAME OVER!", 20, 20);
-        ssd1306_draw_string(&ssd, "Voce perdeu!", 20, 35);
-        ssd1306_send_data(&ssd);
+// Desenha o snapshot mais recente se o escalonador liberar um quadro
+void update_display(void) {
+    uint32_t now = time_us_32();
+    if (!render_sched_due(&render_sched, now, ssd1306_flush_busy(&ssd))) return;
+
+    PROFILE_START(PROFILE_RENDER);
+    game_view_render(&game_view, &ssd, &frame_snap);
+    PROFILE_STOP(PROFILE_RENDER);
+
+    PROFILE_START(PROFILE_BUS);
+    render_sched_begin(&render_sched, now);
+    ssd1306_send_data_async(&ssd);
+    render_sched_sent(&render_sched, now, ssd1306_flush_bytes(&ssd));
+}
+
+// Taxas para ajuste por placa
+void print_rates(void) {
+    uint32_t now = time_us_32();
+    printf("entrada: %lu Hz, quadros: %lu/s (%lu enviados, %lu sem mudanca), flush medio: %lu us, snapshots mesclados: %lu\n",
+           (unsigned long)rate_counter_get(&input_rate, now),
+           (unsigned long)rate_counter_get(&render_sched.fps, now),
+           (unsigned long)render_sched.frames, (unsigned long)render_sched.skipped,
+           (unsigned long)render_sched.flush_avg_us, (unsigned long)game_snapshot_merged());
+    printf("espelho: %s, %lu quadros, %lu bytes\n", mirror_enabled ? "ligado" : "desligado",
+           (unsigned long)mirror.frames, (unsigned long)mirror.bytes_out);
+    printf("temporizadores: %u armados, pico %u, %lu disparos, %lu ticks atrasados\n",
+           timers.active, timers.high_water, (unsigned long)timers.fired, (unsigned long)timers.late_ticks);
+    printf("flash: setor %u (seq %lu), %lu bytes livres, %lu commits, %lu trocas de setor, %lu setores apagados%s\n",
+           flash_log.active, (unsigned long)flash_log.seq, (unsigned long)flash_log_free(&flash_log),
+           (unsigned long)flash_log.commits, (unsigned long)flash_log.rotations, (unsigned long)flash_log.erases,
+           flash_log_pending(&flash_log) ? ", pendente" : "");
+    printf("partidas: %lu (%lu vitorias, %lu derrotas), vitoria mais rapida: %lu ms\n",
+           (unsigned long)saved_stats.games, (unsigned long)saved_stats.wins, (unsigned long)saved_stats.losses,
+           (unsigned long)saved_stats.best_win_ms);
+}
+
+// Comandos pela USB: 's' imprime as taxas, 't' recomeça o trace, 'd' despeja
+// o trace em hexadecimal, 'm' liga/desliga o espelho do display, 'c' calibra
+// os extremos do joystick; os demais vão para o perfilamento
+void poll_console(void) {
+    int c = getchar_timeout_us(0);
+    if (c == PICO_ERROR_TIMEOUT) return;
+    if (c == 's')
+        print_rates();
+    else if (c == 't')
+        trace_restart();
+    else if (c == 'd')
+        input_trace_dump_hex(&trace);
+    else if (c == 'm')
+        mirror_enabled = !mirror_enabled;
+    else if (c == 'c') {
+        printf("joystick: gire ate o fim do curso em todas as direcoes\n");
+        joystick_calibration_begin(&joystick);
+        joystick_calibration_end_us = time_us_32() + JOYSTICK_CALIBRATION_US;
     }
+    else
+        PROFILE_COMMAND(c);
 }
 
 // Callback para piscar LEDs
-bool blink_led_callback(struct repeating_timer *t) {
+bool blink_led_callback(timer_wheel_timer_t *timer, void *user_data) {
     if (led_blink_count > 0) {
-        if (victory) {
+        if (blink_victory) {
             // Piscar em verde para vitória
             set_rgb_led(0, led_state ? 1 : 0, 0);
         } else {
@@ -248,9 +588,6 @@ bool blink_led_callback(struct repeating_timer *t) {
         if (!led_state) led_blink_count--;
         return true;
     }
-    cancel_repeating_timer(t);
-    free(blink_timer_ptr);
-    blink_timer_ptr = NULL;
     return false;
 }
 
@@ -258,15 +595,71 @@ bool blink_led_callback(struct repeating_timer *t) {
 int main() {
     stdio_init_all();
     init_peripherals();
-
-    gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &button_handler);
-    gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &button_handler);
-    gpio_set_irq_enabled_with_callback(JOYSTICK_BTN, GPIO_IRQ_EDGE_FALL, true, &button_handler);
-
-    add_repeating_timer_ms(20, game_loop, NULL, &game_timer);
-
+    // Centro medido com o joystick solto; os extremos padrão valem até um 'c'
+    joystick_init(&joystick, &joystick_default_config, GAME_WIDTH, GAME_HEIGHT, true);
+    joystick_set_center(&joystick, adc_capture_read(1), adc_capture_read(0));
+
+    // Recuperação do log: só lê a flash, antes do core1 partir
+    flash_log_init(&flash_log, FLASH_LOG_OFFSET, FLASH_LOG_SECTORS);
+    flash_log_get(&flash_log, FLASH_REC_STATS, &saved_stats, sizeof(saved_stats));
+    joystick_axis_cal_t saved_cal[2];
+    if (flash_log_get(&flash_log, FLASH_REC_JOYSTICK, saved_cal, sizeof(saved_cal)))
+        joystick_set_extents(&joystick, saved_cal);
+    game_init(&game);
+    // Semente dos alvos: ruído do microfone e o tempo até aqui
+    game_seed(&game, time_us_32() ^ ((uint32_t)adc_capture_latest(2) << 16));
+    game_start_us = time_us_32();
+
+    timers_init();
+    buttons_init(pio1, button_pins, COUNT_OF(button_pins), BUTTON_DEBOUNCE_US, button_event_callback);
+
+    PROFILE_INIT_CORE();
+    queue_init(&mirror_queue, sizeof(mirror_packet_t), MIRROR_QUEUE_PACKETS);
+#if MULTICORE_RENDER
+    multicore_launch_core1(core1_entry);
+#else
+    render_core_init();
+#endif
+
+    // Tick periódico da roda: taxa fixa, independente da duração do callback
+    rate_counter_init(&input_rate, time_us_32());
+    input_trace_init(&trace, trace_buffer, sizeof(trace_buffer));
+    input_trace_start(&trace, time_us_32());
+    timers_start(&input_tick_timer, INPUT_TICK_US / TIMER_WHEEL_TICK_US, INPUT_TICK_US / TIMER_WHEEL_TICK_US,
+                 input_tick_callback);
+
+    // Loop principal orientado a eventos; dorme em __wfe() até a próxima IRQ.
+    // Só publica snapshots que mudaram: sem mudança visível não há quadro.
+    game_snapshot_t published = {0};
     while (1) {
-        tight_loop_contents();
+        event_t event;
+        bool changed = false;
+        PROFILE_START(PROFILE_LOGIC);
+        while (event_queue_pop(&event)) {
+            handle_event(&event);
+            changed = true;
+        }
+
+        if (changed) {
+            PROFILE_STOP(PROFILE_LOGIC);
+            game_snapshot_t snap;
+            game_snapshot(&game, &snap);
+            if (!game_snapshot_equal(&snap, &published)) {
+                published = snap;
+#if MULTICORE_RENDER
+                game_snapshot_publish(&snap);
+#else
+                render_snapshot(&snap);
+#endif
+            }
+        }
+#if !MULTICORE_RENDER
+        update_display();
+        mirror_poll();
+#endif
+        mirror_drain();
+        poll_console();
+        __wfe();
     }
     return 0;
 }
@@ -278,37 +671,21 @@ void init_peripherals(void) {
     gpio_set_function(OLED_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(OLED_SDA);
     gpio_pull_up(OLED_SCL);
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, OLED_ADDR, I2C_PORT);
+    ssd1306_init(&ssd, false, OLED_ADDR, I2C_PORT);
     ssd1306_config(&ssd);
     ssd1306_fill(&ssd, false);
     ssd1306_send_data(&ssd);
 
-    PIO pio = pio0;
-    uint sm = 0;
-    uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, sm, offset, LED_MATRIX_PIN, 800000, false);
-
-    gpio_set_function(BUZZER1, GPIO_FUNC_PWM);
-    gpio_set_function(BUZZER2, GPIO_FUNC_PWM);
-    uint slice_num1 = pwm_gpio_to_slice_num(BUZZER1);
-    uint slice_num2 = pwm_gpio_to_slice_num(BUZZER2);
-    pwm_set_wrap(slice_num1, 1000);
-    pwm_set_wrap(slice_num2, 1000);
-
-    gpio_init(BUTTON_A);
-    gpio_set_dir(BUTTON_A, GPIO_IN);
-    gpio_pull_up(BUTTON_A);
-    gpio_init(BUTTON_B);
-    gpio_set_dir(BUTTON_B, GPIO_IN);
-    gpio_pull_up(BUTTON_B);
-    gpio_init(JOYSTICK_BTN);
-    gpio_set_dir(JOYSTICK_BTN, GPIO_IN);
-    gpio_pull_up(JOYSTICK_BTN);
+    ws2812_init(pio0, 0, LED_MATRIX_PIN);
+
+    audio_init(BUZZER1, BUZZER2);
 
     adc_init();
     adc_gpio_init(JOYSTICK_X);
     adc_gpio_init(JOYSTICK_Y);
     adc_gpio_init(MICROPHONE);
+    adc_capture_init(ADC_SAMPLE_RATE);
+    mic_dsp_init(&mic_dsp);
 
     gpio_init(LED_R);
     gpio_set_dir(LED_R, GPIO_OUT);
@@ -318,123 +695,110 @@ void init_peripherals(void) {
     gpio_set_dir(LED_B, GPIO_OUT);
 }
 
-// Leitura do joystick
+// Leitura do joystick: filtro e tabelas do módulo joystick; o cursor só
+// anda com o jogo aceitando entrada
 void read_joystick(void) {
-    adc_select_input(1);
-    uint16_t x_val = adc_read();
-    adc_select_input(0);
-    uint16_t y_val = adc_read();
-    
-    cursor_x = (x_val * WIDTH) / 4096;
-    cursor_y = ((4095 - y_val) * HEIGHT) / 4096;
+    PROFILE_START(PROFILE_ADC);
+    uint16_t raw_x = adc_capture_read(1), raw_y = adc_capture_read(0);
+    PROFILE_START(PROFILE_JOYSTICK);
+    joystick_update(&joystick, raw_x, raw_y);
+    PROFILE_STOP(PROFILE_JOYSTICK);
+
+    if (joystick.calibrating && (int32_t)(time_us_32() - joystick_calibration_end_us) >= 0) {
+        bool ok = joystick_calibration_end(&joystick);
+        // Gravada na flash junto com o próximo fim de partida
+        if (ok)
+            flash_log_put(&flash_log, FLASH_REC_JOYSTICK, joystick.cal, sizeof(joystick.cal));
+        printf("joystick: calibracao %s (x %u..%u..%u, y %u..%u..%u)\n", ok ? "aplicada" : "descartada",
+               joystick.cal[0].min, joystick.cal[0].center, joystick.cal[0].max,
+               joystick.cal[1].min, joystick.cal[1].center, joystick.cal[1].max);
+    }
 
-    if (cursor_x >= WIDTH) cursor_x = WIDTH - 1;
-    if (cursor_y >= HEIGHT) cursor_y = HEIGHT - 1;
+    // Só posições novas do cursor afetam o jogo e entram no trace
+    if (game_accepts_input(&game) && (joystick.x != game.cursor_x || joystick.y != game.cursor_y)) {
+        game_set_cursor(&game, joystick.x, joystick.y);
+        input_trace_cursor(&trace, time_us_32(), joystick.x, joystick.y);
+    }
+    PROFILE_STOP(PROFILE_ADC);
 }
 
-// Detecção de som alto
+// Detecção de palma: consome as amostras novas do microfone em blocos e
+// retorna true se algum bloco disparou um ataque
 bool detect_loud_sound(void) {
-    adc_select_input(2);
-    uint16_t mic_val = adc_read();
-    return mic_val > 3000;
+    bool onset = false;
+    uint32_t n;
+    while ((n = adc_capture_fetch(2, &mic_cursor, mic_block + mic_block_fill,
+                                  MIC_DSP_BLOCK - mic_block_fill)) > 0) {
+        mic_block_fill += n;
+        if (mic_block_fill == MIC_DSP_BLOCK) {
+            onset |= mic_dsp_process_block(&mic_dsp, mic_block, MIC_DSP_BLOCK);
+            mic_block_fill = 0;
+        }
+    }
+    return onset;
 }
 
 // Funções de áudio
+#define VOICE_BUZZER1 0
+#define VOICE_BUZZER2 1
+
+// Jingles tocados nas duas vozes ao mesmo tempo
+static const audio_note_t victory_melody[] = {
+    {1047, 120, 255}, {1319, 120, 255}, {1568, 120, 255}, {2093, 360, 255},
+};
+static const audio_note_t victory_harmony[] = {
+    {523, 120, 160}, {659, 120, 160}, {784, 120, 160}, {1047, 360, 160},
+};
+static const audio_note_t game_over_melody[] = {
+    {784, 180, 255}, {0, 40, 0}, {659, 180, 255}, {0, 40, 0}, {523, 180, 255}, {392, 480, 255},
+};
+static const audio_note_t game_over_bass[] = {
+    {196, 440, 180}, {131, 660, 180},
+};
+
+// Toca um tom de 200 ms no buzzer indicado
 void play_sound(uint buzzer, uint freq) {
-    uint slice_num = pwm_gpio_to_slice_num(buzzer);
-    uint chan = pwm_gpio_to_channel(buzzer);
-    uint wrap = 125000000 / freq;
-    pwm_set_wrap(slice_num, wrap);
-    pwm_set_chan_level(slice_num, chan, wrap / 2);
-    pwm_set_enabled(slice_num, true);
-    sound_active = true;
-    add_alarm_in_ms(200, stop_sound, (void *)(uint32_t)buzzer, false);
-}
-
-int64_t stop_sound(alarm_id_t id, void *user_data) {
-    uint buzzer = (uint)(uint32_t)user_data;
-    uint slice_num = pwm_gpio_to_slice_num(buzzer);
-    pwm_set_enabled(slice_num, false);
-    sound_active = false;
-    return 0;
+    audio_play_tone(buzzer == BUZZER2 ? VOICE_BUZZER2 : VOICE_BUZZER1, freq, 200, AUDIO_VOLUME_MAX);
 }
 
 // Controle da matriz de LEDs
 void update_led_matrix(uint8_t progress) {
-    uint32_t colors[25] = {0};
-    for (uint i = 0; i < progress && i < 25; i++) {
-        colors[i] = 0xFF0000;  // Verde em GRB
-    }
-    for (uint i = 0; i < 25; i++) {
-        pio_sm_put_blocking(pio0, 0, colors[i] << 8u);
-    }
+    PROFILE_START(PROFILE_LED);
+    ws2812_fill_progress(progress, ws2812_rgb(0, 255, 0), 0);
+    ws2812_show();
+    PROFILE_STOP(PROFILE_LED);
 }
 
 // LED RGB
 void set_rgb_led(uint8_t r, uint8_t g, uint8_t b) {
-    gpio_put(LED_R, r);
-    gpio_put(LED_G, g);
-    gpio_put(LED_B, b);
+    hal_gpio_put(LED_R, r);
+    hal_gpio_put(LED_G, g);
+    hal_gpio_put(LED_B, b);
 }
 
-// Telas de vitória/derrota
+// Fim de partida: matriz, jingle e LED piscando; a tela final é desenhada
+// pelo escalonador a partir do snapshot
 void show_victory_screen(void) {
     update_led_matrix(25);
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, "PARABENS!", 20, 20);
-    ssd1306_draw_string(&ssd, "Score: 25", 30, 35);
-    ssd1306_draw_string(&ssd, "VOCE COMPLETOU!", 5, 50);
-    ssd1306_send_data(&ssd);
-    
-    play_sound(BUZZER1, 2500);
-    
-    if (blink_timer_ptr) {
-        cancel_repeating_timer(blink_timer_ptr);
-        free(blink_timer_ptr);
-        blink_timer_ptr = NULL;
-    }
+
+    audio_play(VOICE_BUZZER1, victory_melody, COUNT_OF(victory_melody));
+    audio_play(VOICE_BUZZER2, victory_harmony, COUNT_OF(victory_harmony));
+
+    // Para o pisca anterior antes de mexer no estado dele
+    timers_cancel(&blink_timer);
     led_blink_count = 20;
     led_state = true;
-    blink_timer_ptr = (struct repeating_timer *)malloc(sizeof(struct repeating_timer));
-    add_repeating_timer_ms(250, blink_led_callback, NULL, blink_timer_ptr);
+    blink_victory = true;
+    timers_start(&blink_timer, TIMER_WHEEL_MS(250), TIMER_WHEEL_MS(250), blink_led_callback);
 }
 
 void show_game_over_screen(void) {
-    ssd1306_fill(&ssd, false);
-    ssd1306_draw_string(&ssd, "GAME OVER!", 20, 20);
-    ssd1306_draw_string(&ssd, "Voce perdeu!", 20, 35);
-    ssd1306_send_data(&ssd);
-    
-    play_sound(BUZZER2, 3000);
-    
-    if (blink_timer_ptr) {
-        cancel_repeating_timer(blink_timer_ptr);
-        free(blink_timer_ptr);
-        blink_timer_ptr = NULL;
-    }
+    audio_play(VOICE_BUZZER1, game_over_melody, COUNT_OF(game_over_melody));
+    audio_play(VOICE_BUZZER2, game_over_bass, COUNT_OF(game_over_bass));
+
+    timers_cancel(&blink_timer);
     led_blink_count = 20;
     led_state = true;
-    blink_timer_ptr = (struct repeating_timer *)malloc(sizeof(struct repeating_timer));
-    add_repeating_timer_ms(250, blink_led_callback, NULL, blink_timer_ptr);
-}
-
-// Reinicia o jogo
-void reset_game(void) {
-    score = 0;
-    click_count = 0;
-    game_over = false;
-    victory = false;
-    playing = true;
-    paused = false;
-    cursor_x = WIDTH/2;
-    cursor_y = HEIGHT/2;
-    target_x = (rand() % (WIDTH - 4)) + 2;
-    target_y = (rand() % (HEIGHT - 4)) + 2;
-    update_led_matrix(0);
-    set_rgb_led(0, 1, 0);
-    if (blink_timer_ptr) {
-        cancel_repeating_timer(blink_timer_ptr);
-        free(blink_timer_ptr);
-        blink_timer_ptr = NULL;
-    }
-}
\ No newline at end of file
+    blink_victory = false;
+    timers_start(&blink_timer, TIMER_WHEEL_MS(250), TIMER_WHEEL_MS(250), blink_led_callback);
+}
@@ -0,0 +1,127 @@
+// Benchmark do conjunto de entidades no host: custo por tick conforme o
+// número de entidades cresce.
+//
+// Uso: bench_entities [--ticks N] [--seed S]
+//
+// Para cada quantidade (8 a ENTITIES_MAX, um quarto de obstáculos) mede em
+// ns: o passo de física com a remontagem da grade, o desenho dos sprites num
+// framebuffer limpo e um teste de acerto do cursor pela grade, ao lado do
+// mesmo teste por varredura linear; tick_ns soma passo, desenho e acerto.
+// Confere também que a grade e a varredura acham um alvo à mesma distância:
+// com mismatches diferente de 0 em alguma linha, retorna 1.
+// Saída em CSV, uma linha por quantidade.
+
+#include "entities.h"
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static entities_t ents;
+static ssd1306_t ssd;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint32_t rng = 1;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Referência: distância (Chebyshev) do alvo mais próximo, varrendo todos
+static int linear_hit_dist(uint8_t x, uint8_t y, uint8_t radius) {
+    int best = radius;
+    for (uint8_t i = 0; i < ents.count; ++i) {
+        if (ents.kind[i] != ENTITY_TARGET) continue;
+        int dx = abs(ents.px[i] - x), dy = abs(ents.py[i] - y);
+        int dist = dx > dy ? dx : dy;
+        if (dist < best) best = dist;
+    }
+    return best < radius ? best : -1;
+}
+
+static int hit_dist(int i, uint8_t x, uint8_t y) {
+    if (i == ENTITY_NONE) return -1;
+    int dx = abs(ents.px[i] - x), dy = abs(ents.py[i] - y);
+    return dx > dy ? dx : dy;
+}
+
+static void populate(int count) {
+    entities_init(&ents);
+    for (int i = 0; i < count; ++i) {
+        entity_kind_t kind = i % 4 == 3 ? ENTITY_OBSTACLE : ENTITY_TARGET;
+        int16_t speed = kind == ENTITY_OBSTACLE ? ENTITY_ONE / 4 : ENTITY_ONE;
+        entities_spawn(&ents, kind, next_random() % GAME_WIDTH, next_random() % GAME_HEIGHT,
+                       (int16_t)(next_random() % (2 * speed + 1)) - speed,
+                       (int16_t)(next_random() % (2 * speed + 1)) - speed);
+    }
+}
+
+int main(int argc, char **argv) {
+    long ticks = 20000;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--ticks") && i + 1 < argc) ticks = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) rng = (uint32_t)atoi(argv[++i]) | 1;
+        else {
+            fprintf(stderr, "uso: %s [--ticks N] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    long total_mismatches = 0;
+    printf("entities,step_ns,hit_grid_ns,hit_linear_ns,render_ns,tick_ns,bounces,mismatches\n");
+    for (int count = 8; count <= ENTITIES_MAX; count *= 2) {
+        populate(count);
+
+        // Cursores pré-sorteados para o tempo não incluir o gerador
+        static uint8_t cursor[4096][2];
+        for (int i = 0; i < 4096; ++i) {
+            cursor[i][0] = next_random() % GAME_WIDTH;
+            cursor[i][1] = next_random() % GAME_HEIGHT;
+        }
+
+        double step = 0, render = 0;
+        for (long t = 0; t < ticks; ++t) {
+            double start = now_ns();
+            entities_step(&ents);
+            double mid = now_ns();
+            ssd1306_fill(&ssd, false);
+            entities_render(&ents, &ssd);
+            render += now_ns() - mid;
+            step += mid - start;
+        }
+
+        // Testes de acerto em lote sobre o estado final, para o relógio não
+        // pesar mais que a consulta
+        volatile int sink = 0;
+        double start = now_ns();
+        for (long t = 0; t < ticks; ++t)
+            sink += entities_hit(&ents, cursor[t & 4095][0], cursor[t & 4095][1], GAME_HIT_RADIUS);
+        double grid = now_ns() - start;
+        start = now_ns();
+        for (long t = 0; t < ticks; ++t)
+            sink += linear_hit_dist(cursor[t & 4095][0], cursor[t & 4095][1], GAME_HIT_RADIUS);
+        double linear = now_ns() - start;
+        (void)sink;
+
+        long mismatches = 0;
+        for (int i = 0; i < 4096; ++i) {
+            uint8_t cx = cursor[i][0], cy = cursor[i][1];
+            mismatches += hit_dist(entities_hit(&ents, cx, cy, GAME_HIT_RADIUS), cx, cy) !=
+                          linear_hit_dist(cx, cy, GAME_HIT_RADIUS);
+        }
+
+        printf("%d,%.1f,%.1f,%.1f,%.1f,%.1f,%u,%ld\n", count, step / ticks, grid / ticks, linear / ticks,
+               render / ticks, (step + grid + render) / ticks, ents.bounces, mismatches);
+        total_mismatches += mismatches;
+    }
+    return total_mismatches ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+// Benchmark do mapeamento do joystick no host: custo por amostra e tremor do
+// cursor com o joystick parado, comparando a conversão direta que o jogo
+// usava antes (direct_cursor) com o módulo joystick (filtro IIR + tabelas).
+//
+// Uso: bench_joystick [--iterations N] [--noise CONTAGENS] [--seed S]
+//
+// Saída em CSV (nome,valor). O tremor é medido com o joystick parado em
+// posições sorteadas e ruído gaussiano de desvio CONTAGENS (padrão 6) somado
+// a cada leitura, a 1 kHz como no firmware: conta quantas vezes por segundo
+// o cursor muda de posição sem o jogador mexer.
+//
+// Os ns por amostra do host só comparam as duas versões entre si (o módulo
+// custa ~3x a conversão direta). No RP2040 o custo vem do estágio "joystick"
+// do perfilamento (-DPROFILE=ON, coluna media_ciclos); pela contagem de
+// instruções do Cortex-M0+ o caminho comum (sem troca de pixel) fica perto de
+// 70 ciclos, ~0,6 µs a 125 MHz, contra ~20 da conversão direta: menos de
+// 0,1% do tick de entrada de 1 ms.
+
+#include "joystick.h"
+#include "game.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SAMPLE_HZ 1000
+#define HOLD_SAMPLES 2000   // Amostras em cada posição parada
+#define HOLD_POSITIONS 64
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double gaussian(void) {
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static uint16_t clamp_adc(double v) {
+    if (v < 0) return 0;
+    if (v > JOYSTICK_ADC_MAX) return JOYSTICK_ADC_MAX;
+    return (uint16_t)lround(v);
+}
+
+// Conversão antiga do read_joystick: multiplicação e divisão por eixo, sem
+// calibração nem filtro; o eixo Y do joystick cresce para cima
+static void direct_cursor(game_t *game, uint16_t adc_x, uint16_t adc_y) {
+    game_set_cursor(game, (adc_x * GAME_WIDTH) / 4096, ((4095 - adc_y) * GAME_HEIGHT) / 4096);
+}
+
+// Leituras pré-sorteadas para o tempo não incluir o gerador de ruído
+static uint16_t *make_samples(long count, double noise) {
+    uint16_t *samples = malloc(count * 2 * sizeof(uint16_t));
+    double cx = 0, cy = 0;
+    for (long i = 0; i < count; ++i) {
+        if (i % HOLD_SAMPLES == 0) {
+            cx = 200 + rand() % 3696;
+            cy = 200 + rand() % 3696;
+        }
+        samples[2 * i] = clamp_adc(cx + noise * gaussian());
+        samples[2 * i + 1] = clamp_adc(cy + noise * gaussian());
+    }
+    return samples;
+}
+
+int main(int argc, char **argv) {
+    long iterations = 5000000;
+    double noise = 6.0;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc) iterations = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--noise") && i + 1 < argc) noise = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (unsigned)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "uso: %s [--iterations N] [--noise CONTAGENS] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    srand(seed);
+
+    // Custo por amostra
+    uint16_t *samples = make_samples(4096, noise);
+    static game_t game;
+    game_init(&game);
+    static joystick_t js;
+    joystick_init(&js, &joystick_default_config, GAME_WIDTH, GAME_HEIGHT, true);
+
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i) {
+        long k = i & 4095;
+        direct_cursor(&game, samples[2 * k], samples[2 * k + 1]);
+    }
+    double raw_ns = (now_ns() - start) / iterations;
+
+    volatile uint32_t sink = 0;
+    start = now_ns();
+    for (long i = 0; i < iterations; ++i) {
+        long k = i & 4095;
+        sink += joystick_update(&js, samples[2 * k], samples[2 * k + 1]);
+    }
+    double js_ns = (now_ns() - start) / iterations;
+    (void)sink;
+    free(samples);
+
+    // Tremor com o joystick parado
+    const long count = (long)HOLD_SAMPLES * HOLD_POSITIONS;
+    samples = make_samples(count, noise);
+    game_init(&game);
+    joystick_init(&js, &joystick_default_config, GAME_WIDTH, GAME_HEIGHT, true);
+    long raw_moves = 0, js_moves = 0;
+    for (long i = 0; i < count; ++i) {
+        uint8_t cx = game.cursor_x, cy = game.cursor_y;
+        direct_cursor(&game, samples[2 * i], samples[2 * i + 1]);
+        bool js_moved = joystick_update(&js, samples[2 * i], samples[2 * i + 1]);
+        // A primeira amostra de cada posição é o salto até ela, não tremor
+        if (i % HOLD_SAMPLES < 50) continue;
+        raw_moves += game.cursor_x != cx || game.cursor_y != cy;
+        js_moves += js_moved;
+    }
+    free(samples);
+    double seconds = (double)HOLD_POSITIONS * (HOLD_SAMPLES - 50) / SAMPLE_HZ;
+
+    printf("nome,valor\n");
+    printf("raw_ns_per_sample,%.2f\n", raw_ns);
+    printf("joystick_ns_per_sample,%.2f\n", js_ns);
+    printf("noise_counts,%.1f\n", noise);
+    printf("raw_jitter_moves_per_s,%.2f\n", raw_moves / seconds);
+    printf("joystick_jitter_moves_per_s,%.2f\n", js_moves / seconds);
+    return 0;
+}
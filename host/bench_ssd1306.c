@@ -0,0 +1,243 @@
+// Micro-benchmarks da pilha de renderização SSD1306 no host.
+//
+// Uso: bench_ssd1306 [--json] [--iterations N] [--baseline arquivo.csv] [--threshold PCT]
+//
+// Sem --json a saída é CSV (nome,ns_por_op,bytes_por_quadro). Com --baseline,
+// compara com um CSV salvo anteriormente e termina com código 1 se alguma
+// primitiva ficar mais de PCT% (padrão 10) mais lenta ou se faltar o
+// resultado de algum nome da referência.
+
+#include "ssd1306.h"
+#include "game_render.h"
+#include "hal_host.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_RESULTS 16
+
+typedef struct {
+    const char *name;
+    double ns_per_op;
+    double bytes_per_frame;  // Só para os casos que enviam ao display
+} bench_result_t;
+
+static ssd1306_t ssd;
+static game_view_t view;
+static bench_result_t results[MAX_RESULTS];
+static int result_count = 0;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void record(const char *name, double ns_per_op, double bytes_per_frame) {
+    results[result_count].name = name;
+    results[result_count].ns_per_op = ns_per_op;
+    results[result_count].bytes_per_frame = bytes_per_frame;
+    result_count++;
+}
+
+static void bench_pixel(long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i)
+        ssd1306_pixel(&ssd, i & 127, (i >> 7) & 63, i & 1);
+    record("ssd1306_pixel", (now_ns() - start) / iterations, 0);
+}
+
+static void bench_fill(long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i)
+        ssd1306_fill(&ssd, i & 1);
+    record("ssd1306_fill", (now_ns() - start) / iterations, 0);
+}
+
+static void bench_line(long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i)
+        ssd1306_line(&ssd, i & 127, 0, 127 - (i & 127), 63, true);
+    record("ssd1306_line", (now_ns() - start) / iterations, 0);
+}
+
+static void bench_rect(long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i)
+        ssd1306_rect(&ssd, i & 31, i & 63, 40, 24, true, i & 1);
+    record("ssd1306_rect", (now_ns() - start) / iterations, 0);
+}
+
+static void bench_draw_string(long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i)
+        ssd1306_draw_string(&ssd, "Score: 25", 0, i & 7);
+    record("ssd1306_draw_string", (now_ns() - start) / iterations, 0);
+}
+
+// Roteiro dos quadros: cursor andando um pixel por quadro e pontuação
+// mudando de vez em quando
+static void bench_frame_snapshot(game_snapshot_t *snap, long i) {
+    snap->cursor_x = 2 + (i % 124);
+    snap->cursor_y = 2 + ((i / 124) % 60);
+    snap->score = (i / 64) % 26;
+    snap->click_count = (i / 16) % 11;
+}
+
+// Redesenho completo do HUD, para comparar com a cena retida
+static void bench_frame_full(long iterations) {
+    game_snapshot_t snap = {0};
+    snap.target_x = 90;
+    snap.target_y = 40;
+    snap.playing = true;
+
+    double start = now_ns();
+    for (long i = 0; i < iterations; ++i) {
+        bench_frame_snapshot(&snap, i);
+        game_render_hud(&ssd, &snap);
+    }
+    record("frame_render_full", (now_ns() - start) / iterations, 0);
+}
+
+// Quadro equivalente ao update_display: HUD pela cena retida + flush
+static void bench_frame(long iterations) {
+    game_snapshot_t snap = {0};
+    snap.target_x = 90;
+    snap.target_y = 40;
+    snap.playing = true;
+
+    game_view_init(&view);
+    game_view_render(&view, &ssd, &snap);
+    ssd1306_invalidate(&ssd);
+    ssd1306_send_data(&ssd);
+    hal_host_i2c_clear();
+
+    double render_ns = 0, flush_ns = 0;
+    for (long i = 0; i < iterations; ++i) {
+        bench_frame_snapshot(&snap, i);
+
+        double t0 = now_ns();
+        game_view_render(&view, &ssd, &snap);
+        double t1 = now_ns();
+        ssd1306_send_data(&ssd);
+        double t2 = now_ns();
+        render_ns += t1 - t0;
+        flush_ns += t2 - t1;
+    }
+    double bytes = (double)hal_host_i2c_bytes() / iterations;
+    record("frame_render", render_ns / iterations, 0);
+    record("frame_flush", flush_ns / iterations, bytes);
+    record("frame_total", (render_ns + flush_ns) / iterations, bytes);
+}
+
+static void print_csv(void) {
+    printf("name,ns_per_op,bytes_per_frame\n");
+    for (int i = 0; i < result_count; ++i)
+        printf("%s,%.2f,%.1f\n", results[i].name, results[i].ns_per_op, results[i].bytes_per_frame);
+}
+
+static void print_json(void) {
+    printf("[\n");
+    for (int i = 0; i < result_count; ++i) {
+        printf("  {\"name\": \"%s\", \"ns_per_op\": %.2f, \"bytes_per_frame\": %.1f}%s\n",
+               results[i].name, results[i].ns_per_op, results[i].bytes_per_frame,
+               i + 1 < result_count ? "," : "");
+    }
+    printf("]\n");
+}
+
+// Compara com um CSV de referência; retorna o número de regressões. Um nome
+// da referência sem resultado atual (benchmark renomeado ou removido) também
+// conta, senão ele passaria pela comparação sem ser medido.
+static int compare_baseline(const char *path, double threshold_pct) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "baseline: nao foi possivel abrir %s\n", path);
+        return -1;
+    }
+
+    char line[256];
+    int regressions = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char name[64];
+        double base_ns, base_bytes;
+        if (sscanf(line, "%63[^,],%lf,%lf", name, &base_ns, &base_bytes) != 3) continue;
+        // Sem tempo de referência positivo não há porcentagem a comparar
+        if (!(base_ns > 0)) {
+            fprintf(stderr, "%-22s baseline invalida (%.2f ns), ignorada\n", name, base_ns);
+            continue;
+        }
+
+        bool matched = false;
+        for (int i = 0; i < result_count; ++i) {
+            if (strcmp(results[i].name, name) != 0) continue;
+            matched = true;
+            double delta = (results[i].ns_per_op - base_ns) * 100.0 / base_ns;
+            bool regressed = delta > threshold_pct;
+            fprintf(stderr, "%-22s %10.2f -> %10.2f ns (%+6.1f%%)%s\n",
+                    name, base_ns, results[i].ns_per_op, delta, regressed ? "  REGRESSAO" : "");
+            regressions += regressed;
+        }
+        if (!matched) {
+            fprintf(stderr, "%-22s %10.2f -> sem resultado  REGRESSAO\n", name, base_ns);
+            regressions++;
+        }
+    }
+    fclose(f);
+    return regressions;
+}
+
+// Iterações: inteiro de 1 em diante (o pixel roda 50 vezes mais)
+static bool parse_iterations(const char *text, long *out) {
+    char *end;
+    errno = 0;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end || errno || value < 1 || value > LONG_MAX / 50) return false;
+    *out = value;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    bool json = false;
+    long iterations = 20000;
+    const char *baseline = NULL;
+    double threshold = 10.0;
+
+    for (int i = 1; i < argc; ++i) {
+        bool valid = true;
+        if (!strcmp(argv[i], "--json")) json = true;
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc) valid = parse_iterations(argv[++i], &iterations);
+        else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baseline = argv[++i];
+        else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = atof(argv[++i]);
+        else valid = false;
+        if (!valid) {
+            fprintf(stderr, "uso: %s [--json] [--iterations N] [--baseline arquivo.csv] [--threshold PCT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    hal_host_reset();
+    ssd1306_init(&ssd, false, 0x3C, NULL);
+
+    bench_pixel(iterations * 50);
+    bench_fill(iterations);
+    bench_line(iterations);
+    bench_rect(iterations);
+    bench_draw_string(iterations);
+    bench_frame_full(iterations);
+    bench_frame(iterations);
+
+    if (json)
+        print_json();
+    else
+        print_csv();
+
+    if (baseline) {
+        int regressions = compare_baseline(baseline, threshold);
+        if (regressions != 0) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Simulador do log persistente (inc/flash_log.c) sobre a flash emulada da
+// HAL de host, para ver desgaste, paradas da XIP e recuperação.
+//
+// Uso: flash_sim [--games N] [--sectors S] [--cut-rate P] [--seed S]
+//
+// Cada partida atualiza os mesmos registros que o firmware (estatísticas e
+// última partida; a calibração do joystick de vez em quando) e termina com
+// commits até não sobrar nada pendente. Com probabilidade P eles são
+// cortados por uma queda de energia depois de um número sorteado de bytes; a
+// cada queda, e a cada 100 partidas sem queda, o log é recuperado do zero a
+// partir da flash e conferido: cada tipo tem de voltar com a versão de antes
+// ou a de depois do commit interrompido, nunca outra coisa.
+//
+// Saída em CSV nome,valor: commits, trocas de setor, setores apagados
+// (mínimo e máximo por setor: nivelamento), maior parada da XIP num commit,
+// quedas, falhas de recuperação, commits que apagaram e gravaram juntos e
+// violações das regras da flash; retorna 1 se algum dos três últimos não é 0.
+
+#include "flash_log.h"
+#include "hal_host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TYPES 3  // Estatísticas, última partida, calibração
+
+typedef struct {
+  uint8_t len[TYPES];
+  uint8_t data[TYPES][FLASH_LOG_MAX_PAYLOAD];
+} model_t;
+
+static flash_log_t log_state;
+static model_t committed;  // Versão gravada: a do último commit completo
+static uint32_t rng = 1;
+
+static uint32_t next_random(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static void model_capture(model_t *model) {
+    memset(model, 0, sizeof(*model));
+    for (int t = 0; t < TYPES; ++t) {
+        model->len[t] = log_state.len[t];
+        if (log_state.valid & (1u << t))
+            memcpy(model->data[t], log_state.data[t], log_state.len[t]);
+        else
+            model->len[t] = 0;
+    }
+}
+
+static bool model_matches(const model_t *model, int t) {
+    bool valid = log_state.valid & (1u << t);
+    if (!valid) return model->len[t] == 0;
+    return log_state.len[t] == model->len[t] && !memcmp(log_state.data[t], model->data[t], model->len[t]);
+}
+
+int main(int argc, char **argv) {
+    long games = 100000;
+    int sectors = 8;
+    double cut_rate = 0.01;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--games") && i + 1 < argc) games = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--sectors") && i + 1 < argc) sectors = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--cut-rate") && i + 1 < argc) cut_rate = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) rng = (uint32_t)atoi(argv[++i]) | 1;
+        else {
+            fprintf(stderr, "uso: %s [--games N] [--sectors S] [--cut-rate P] [--seed S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (sectors < 2 || sectors > FLASH_LOG_MAX_SECTORS) {
+        fprintf(stderr, "--sectors entre 2 e %d\n", FLASH_LOG_MAX_SECTORS);
+        return 2;
+    }
+
+    const uint32_t offset = HAL_HOST_FLASH_SIZE - sectors * HAL_FLASH_SECTOR_SIZE;
+    hal_host_flash_reset();
+    flash_log_init(&log_state, offset, sectors);
+
+    uint32_t stats[5] = {0};  // Partidas, vitórias, derrotas, acertos, melhor tempo
+    uint32_t commits = 0, rotations = 0, cuts = 0, reboots = 0, failures = 0, bad_records = 0, mixed_commits = 0;
+    uint32_t max_commit_stall_us = 0, max_append_stall_us = 0;
+    uint64_t total_stall_us = 0;
+
+    for (long g = 0; g < games; ++g) {
+        // Fim de uma partida, como record_game_end no firmware
+        uint8_t last[8];
+        stats[0]++;
+        stats[1 + (next_random() & 1)]++;
+        stats[3] += next_random() % 26;
+        stats[4] = 20000 + next_random() % 60000;
+        for (int i = 0; i < 8; ++i) last[i] = next_random();
+        flash_log_put(&log_state, 0, stats, sizeof(stats));
+        flash_log_put(&log_state, 1, last, sizeof(last));
+        if (next_random() % 50 == 0) {
+            uint16_t cal[6];
+            for (int i = 0; i < 6; ++i) cal[i] = next_random() & 0xFFF;
+            flash_log_put(&log_state, 2, cal, sizeof(cal));
+        }
+
+        model_t before = committed, after;
+        model_capture(&after);
+
+        bool cut = (next_random() % 1000000) < cut_rate * 1000000;
+        if (cut) hal_host_flash_cut_after(next_random() % 1200);
+
+        // Como o firmware: commits seguidos, ainda na tela final, enquanto
+        // sobrar algo pendente. Nenhum pode apagar e gravar junto.
+        const hal_host_flash_stats_t *fs = hal_host_flash_stats();
+        for (int pass = 0; pass < 3 && flash_log_pending(&log_state) && hal_host_flash_powered(); ++pass) {
+            uint64_t stall_before = fs->stall_us;
+            uint32_t ops_before = fs->operations;
+            uint32_t rotations_before = log_state.rotations, erases_before = log_state.erases;
+            flash_log_commit(&log_state);
+            uint32_t stall = (uint32_t)(fs->stall_us - stall_before);
+            bool erased = log_state.erases != erases_before;
+            total_stall_us += stall;
+            if (stall > max_commit_stall_us) max_commit_stall_us = stall;
+            if (!erased && log_state.rotations == rotations_before && stall > max_append_stall_us)
+                max_append_stall_us = stall;
+            if (erased && fs->operations - ops_before > 1) mixed_commits++;
+            commits++;
+        }
+
+        bool lost_power = !hal_host_flash_powered();
+        if (cut) hal_host_flash_power_on();
+        if (lost_power) cuts++;
+
+        if (lost_power || g % 100 == 99) {
+            // Reinício: tudo que estava em RAM se perde
+            rotations += log_state.rotations;
+            flash_log_init(&log_state, offset, sectors);
+            bad_records += log_state.bad_records;
+            reboots++;
+            for (int t = 0; t < TYPES; ++t) {
+                bool ok = lost_power ? model_matches(&before, t) || model_matches(&after, t) : model_matches(&after, t);
+                if (!ok) failures++;
+            }
+            if (!flash_log_get(&log_state, 0, stats, sizeof(stats))) memset(stats, 0, sizeof(stats));
+            model_capture(&committed);
+        } else {
+            committed = after;
+        }
+    }
+    rotations += log_state.rotations;
+
+    uint32_t min_erases = UINT32_MAX, max_erases = 0;
+    for (int s = 0; s < sectors; ++s) {
+        uint32_t e = hal_host_flash_sector_erases(offset + s * HAL_FLASH_SECTOR_SIZE);
+        if (e < min_erases) min_erases = e;
+        if (e > max_erases) max_erases = e;
+    }
+
+    const hal_host_flash_stats_t *fs = hal_host_flash_stats();
+    printf("nome,valor\n");
+    printf("games,%ld\n", games);
+    printf("sectors,%d\n", sectors);
+    printf("commits,%u\n", commits);
+    printf("rotations,%u\n", rotations);
+    printf("pages_programmed,%u\n", fs->pages);
+    printf("sector_erases_min,%u\n", min_erases);
+    printf("sector_erases_max,%u\n", max_erases);
+    printf("stall_us_per_commit,%.1f\n", commits ? (double)total_stall_us / commits : 0.0);
+    printf("max_append_stall_us,%u\n", max_append_stall_us);
+    printf("max_commit_stall_us,%u\n", max_commit_stall_us);
+    printf("power_cuts,%u\n", cuts);
+    printf("reboots,%u\n", reboots);
+    printf("bad_records,%u\n", bad_records);
+    printf("recovery_failures,%u\n", failures);
+    printf("erase_and_program_commits,%u\n", mixed_commits);
+    printf("flash_violations,%u\n", fs->violations);
+    return failures || fs->violations || mixed_commits ? 1 : 0;
+}
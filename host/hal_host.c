@@ -0,0 +1,205 @@
+#include "hal_host.h"
+#include <string.h>
+
+static uint8_t i2c_log[HAL_HOST_I2C_LOG_SIZE];
+static size_t i2c_log_len = 0;
+static size_t i2c_bytes = 0;
+static size_t i2c_transactions = 0;
+
+static uint8_t flash[HAL_HOST_FLASH_SIZE];
+static uint32_t flash_sector_erases[HAL_HOST_FLASH_SIZE / HAL_FLASH_SECTOR_SIZE];
+static hal_host_flash_stats_t flash_stats;
+static bool flash_ready = false;
+static bool flash_powered = true;
+static int64_t flash_budget = -1;  // Bytes até a queda de energia; -1 = sem queda
+
+#define MAX_STREAMS 4
+static hal_callback_t stream_callbacks[MAX_STREAMS];
+static void *stream_user_data[MAX_STREAMS];
+static int streams = 0;
+
+void hal_host_reset(void) {
+    hal_host_i2c_clear();
+}
+
+static void i2c_record(uint8_t byte) {
+    if (i2c_log_len < HAL_HOST_I2C_LOG_SIZE)
+        i2c_log[i2c_log_len++] = byte;
+    i2c_bytes++;
+}
+
+int hal_i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)nostop;
+    for (size_t i = 0; i < len; ++i)
+        i2c_record(src[i]);
+    i2c_transactions++;
+    return (int)len;
+}
+
+int hal_i2c_stream_init(i2c_inst_t *i2c) {
+    (void)i2c;
+    return streams < MAX_STREAMS ? streams++ : MAX_STREAMS - 1;
+}
+
+void hal_i2c_stream_set_callback(int stream, hal_callback_t callback, void *user_data) {
+    stream_callbacks[stream] = callback;
+    stream_user_data[stream] = user_data;
+}
+
+// O fluxo é "enviado" na hora: cada RESTART abre uma nova transação
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count) {
+    (void)i2c; (void)addr;
+    for (size_t i = 0; i < count; ++i) {
+        if (i == 0 || (words[i] & HAL_I2C_RESTART)) i2c_transactions++;
+        i2c_record(words[i] & 0xFF);
+    }
+    if (stream_callbacks[stream])
+        stream_callbacks[stream](stream_user_data[stream]);
+}
+
+bool hal_i2c_stream_busy(int stream, i2c_inst_t *i2c) {
+    (void)stream; (void)i2c;
+    return false;
+}
+
+bool hal_i2c_take_abort(i2c_inst_t *i2c) {
+    (void)i2c;
+    return false;
+}
+
+size_t hal_host_i2c_bytes(void) {
+    return i2c_bytes;
+}
+
+size_t hal_host_i2c_transactions(void) {
+    return i2c_transactions;
+}
+
+const uint8_t *hal_host_i2c_log(size_t *len) {
+    *len = i2c_log_len;
+    return i2c_log;
+}
+
+void hal_host_i2c_clear(void) {
+    i2c_log_len = 0;
+    i2c_bytes = 0;
+    i2c_transactions = 0;
+}
+
+void hal_pwm_configure(uint gpio, uint32_t div16, uint32_t wrap) {
+    (void)gpio; (void)div16; (void)wrap;
+}
+
+void hal_pwm_set_level(uint gpio, uint16_t level) {
+    (void)gpio; (void)level;
+}
+
+void hal_pwm_set_enabled(uint gpio, bool enabled) {
+    (void)gpio; (void)enabled;
+}
+
+void hal_gpio_put(uint gpio, bool value) {
+    (void)gpio; (void)value;
+}
+
+// A flash só é apagada no primeiro uso: sobrevive a hal_host_reset, como a
+// da placa sobrevive a um reinício
+static void flash_prepare(void) {
+    if (flash_ready) return;
+    memset(flash, 0xFF, sizeof(flash));
+    flash_ready = true;
+}
+
+void hal_host_flash_reset(void) {
+    flash_ready = false;
+    flash_prepare();
+    memset(flash_sector_erases, 0, sizeof(flash_sector_erases));
+    hal_host_flash_clear_stats();
+    flash_powered = true;
+    flash_budget = -1;
+}
+
+// Quantos dos len bytes a operação chega a escrever antes da queda
+static uint32_t flash_consume(uint32_t len) {
+    if (!flash_powered) return 0;
+    if (flash_budget < 0) return len;
+    if (flash_budget >= len) {
+        flash_budget -= len;
+        return len;
+    }
+    uint32_t done = (uint32_t)flash_budget;
+    flash_budget = -1;
+    flash_powered = false;
+    return done;
+}
+
+static void flash_stall(uint32_t us) {
+    flash_stats.operations++;
+    flash_stats.stall_us += us;
+    if (us > flash_stats.max_stall_us) flash_stats.max_stall_us = us;
+}
+
+const uint8_t *hal_flash_read(uint32_t offset) {
+    flash_prepare();
+    return &flash[offset < HAL_HOST_FLASH_SIZE ? offset : 0];
+}
+
+void hal_flash_erase(uint32_t offset, uint32_t len) {
+    flash_prepare();
+    if (offset % HAL_FLASH_SECTOR_SIZE || len % HAL_FLASH_SECTOR_SIZE || offset + len > HAL_HOST_FLASH_SIZE) {
+        flash_stats.violations++;
+        return;
+    }
+    flash_stall(len / HAL_FLASH_SECTOR_SIZE * HAL_HOST_FLASH_ERASE_US);
+    uint32_t done = flash_consume(len);
+    memset(&flash[offset], 0xFF, done);
+    for (uint32_t s = 0; s < len / HAL_FLASH_SECTOR_SIZE && flash_powered; ++s) {
+        flash_sector_erases[offset / HAL_FLASH_SECTOR_SIZE + s]++;
+        flash_stats.erases++;
+    }
+}
+
+void hal_flash_program(uint32_t offset, const uint8_t *data, uint32_t len) {
+    flash_prepare();
+    if (offset % HAL_FLASH_PAGE_SIZE || len % HAL_FLASH_PAGE_SIZE || offset + len > HAL_HOST_FLASH_SIZE) {
+        flash_stats.violations++;
+        return;
+    }
+    flash_stall(len / HAL_FLASH_PAGE_SIZE * HAL_HOST_FLASH_PAGE_US);
+    uint32_t done = flash_consume(len);
+    for (uint32_t i = 0; i < done; ++i) {
+        // 0xFF não grava nada; outro valor precisa caber nos bits ainda em 1
+        if (data[i] != 0xFF && (flash[offset + i] & data[i]) != data[i]) flash_stats.violations++;
+        flash[offset + i] &= data[i];
+    }
+    if (done == len) flash_stats.pages += len / HAL_FLASH_PAGE_SIZE;
+}
+
+// Sem outro core no host: nada a estacionar
+void hal_flash_park_enable(void) {}
+void hal_flash_park_point(void) {}
+
+const hal_host_flash_stats_t *hal_host_flash_stats(void) {
+    return &flash_stats;
+}
+
+void hal_host_flash_clear_stats(void) {
+    memset(&flash_stats, 0, sizeof(flash_stats));
+}
+
+uint32_t hal_host_flash_sector_erases(uint32_t offset) {
+    return offset < HAL_HOST_FLASH_SIZE ? flash_sector_erases[offset / HAL_FLASH_SECTOR_SIZE] : 0;
+}
+
+void hal_host_flash_cut_after(uint32_t bytes) {
+    flash_budget = bytes;
+}
+
+bool hal_host_flash_powered(void) {
+    return flash_powered;
+}
+
+void hal_host_flash_power_on(void) {
+    flash_powered = true;
+    flash_budget = -1;
+}
@@ -0,0 +1,45 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include "hal.h"
+
+// Implementação da HAL para o build nativo. As transações I2C são
+// registradas em memória para inspeção e a flash é emulada; PWM e GPIO (só
+// usados pelo firmware) não fazem nada.
+
+#define HAL_HOST_I2C_LOG_SIZE 65536
+#define HAL_HOST_FLASH_SIZE (2u * 1024 * 1024)  // Flash da Pico
+#define HAL_HOST_FLASH_ERASE_US 45000u  // Tempo típico de apagar um setor
+#define HAL_HOST_FLASH_PAGE_US 800u     // E de gravar uma página
+
+void hal_host_reset(void);
+
+// I2C: bytes de todas as transações, sem o byte de endereço
+size_t hal_host_i2c_bytes(void);
+size_t hal_host_i2c_transactions(void);
+const uint8_t *hal_host_i2c_log(size_t *len);
+void hal_host_i2c_clear(void);
+
+// Flash emulada como NOR: começa apagada (0xFF), apagar exige setor inteiro
+// alinhado, gravar exige páginas inteiras alinhadas e só leva bits a 0.
+// Violações são contadas, não abortam. Uma queda de energia pode ser
+// programada para depois de N bytes apagados ou gravados: a operação em
+// curso fica pela metade e as seguintes são ignoradas até religar.
+typedef struct {
+  uint32_t erases;          // Setores apagados
+  uint32_t pages;           // Páginas gravadas
+  uint32_t operations;      // Chamadas de apagar e gravar (cada uma para a XIP)
+  uint32_t violations;      // Desalinhamento, fora da flash ou byte que pediria bit de 0 para 1
+  uint64_t stall_us;        // Tempo estimado com a XIP parada
+  uint32_t max_stall_us;    // Maior parada de uma operação
+} hal_host_flash_stats_t;
+
+void hal_host_flash_reset(void);
+const hal_host_flash_stats_t *hal_host_flash_stats(void);
+void hal_host_flash_clear_stats(void);
+uint32_t hal_host_flash_sector_erases(uint32_t offset);
+void hal_host_flash_cut_after(uint32_t bytes);
+bool hal_host_flash_powered(void);
+void hal_host_flash_power_on(void);
+
+#endif
@@ -0,0 +1,122 @@
+// Replay de amostras do microfone pelo front-end de áudio (inc/mic_dsp.c),
+// em blocos de MIC_DSP_BLOCK como no firmware.
+//
+// Uso: mic_replay [--blocks] arquivo...
+//
+// Cada arquivo traz amostras do ADC (12 bits, 10 kHz) em texto, separadas por
+// espaço ou linha. Linhas começadas por '#' são comentários; duas delas dão
+// os valores esperados:
+//   # claps P1 P2 ...   posições (em amostras) das palmas que devem ser
+//                       detectadas; a detecção tem de cair no bloco da palma
+//                       ou em até MAX_DELAY_BLOCKS depois, uma por palma
+//   # floor MIN MAX     faixa do piso de ruído ao fim, em contagens do ADC
+// Sem essas linhas o arquivo só é processado. Imprime uma linha CSV por
+// arquivo (com --blocks, também envelope e piso de cada bloco) e retorna 1 se
+// algum arquivo não bate com o esperado.
+
+#include "mic_dsp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_CLAPS 64
+#define MAX_DELAY_BLOCKS 2
+
+typedef struct {
+  uint32_t claps[MAX_CLAPS];
+  int clap_count;
+  bool has_claps;
+  uint32_t floor_min, floor_max;
+  bool has_floor;
+} expected_t;
+
+static void parse_comment(const char *line, expected_t *exp) {
+    if (!strncmp(line, "# claps", 7)) {
+        const char *p = line + 7;
+        char *end;
+        exp->has_claps = true;
+        for (long v = strtol(p, &end, 10); end != p && exp->clap_count < MAX_CLAPS; v = strtol(p, &end, 10)) {
+            exp->claps[exp->clap_count++] = (uint32_t)v;
+            p = end;
+        }
+    } else if (sscanf(line, "# floor %u %u", &exp->floor_min, &exp->floor_max) == 2) {
+        exp->has_floor = true;
+    }
+}
+
+static int replay(const char *path, bool blocks) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+
+    expected_t exp = {0};
+    mic_dsp_t dsp;
+    mic_dsp_init(&dsp);
+    uint16_t block[MIC_DSP_BLOCK];
+    uint32_t fill = 0, samples = 0, block_index = 0;
+    uint32_t onsets = 0, matched = 0, stray = 0;
+    bool detected[MAX_CLAPS] = {false};
+
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') {
+            parse_comment(line, &exp);
+            continue;
+        }
+        char *p = line, *end;
+        for (long v = strtol(p, &end, 10); end != p; v = strtol(p, &end, 10)) {
+            p = end;
+            block[fill++] = v < 0 ? 0 : v > 4095 ? 4095 : (uint16_t)v;
+            samples++;
+            if (fill < MIC_DSP_BLOCK) continue;
+            fill = 0;
+
+            bool onset = mic_dsp_process_block(&dsp, block, MIC_DSP_BLOCK);
+            if (blocks)
+                printf("%s,%u,%u,%u,%d\n", path, block_index, dsp.envelope >> MIC_DSP_FRAC_BITS,
+                       dsp.noise_floor >> MIC_DSP_FRAC_BITS, onset);
+            if (onset) {
+                onsets++;
+                bool ok = false;
+                for (int c = 0; c < exp.clap_count && !ok; ++c) {
+                    uint32_t clap_block = exp.claps[c] / MIC_DSP_BLOCK;
+                    if (!detected[c] && block_index >= clap_block && block_index <= clap_block + MAX_DELAY_BLOCKS)
+                        detected[c] = ok = true;
+                }
+                if (ok) matched++;
+                else stray++;
+            }
+            block_index++;
+        }
+    }
+    fclose(f);
+
+    uint32_t floor = dsp.noise_floor >> MIC_DSP_FRAC_BITS;
+    bool ok = true;
+    if (exp.has_claps && (matched != (uint32_t)exp.clap_count || stray)) ok = false;
+    if (exp.has_floor && (floor < exp.floor_min || floor > exp.floor_max)) ok = false;
+    printf("%s,%u,%u,%u,%d,%u,%s\n", path, samples, onsets, matched, exp.clap_count, floor, ok ? "ok" : "FALHOU");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    bool blocks = false;
+    int first = 1;
+    if (first < argc && !strcmp(argv[first], "--blocks")) {
+        blocks = true;
+        first++;
+    }
+    if (first >= argc) {
+        fprintf(stderr, "uso: %s [--blocks] arquivo...\n", argv[0]);
+        return 2;
+    }
+
+    if (blocks) printf("arquivo,bloco,envelope,piso,ataque\n");
+    printf("arquivo,amostras,ataques,palmas_certas,palmas_esperadas,piso,resultado\n");
+    int failed = 0;
+    for (int i = first; i < argc; ++i)
+        failed |= replay(argv[i], blocks);
+    return failed;
+}
@@ -0,0 +1,101 @@
+// Decodificador do espelhamento do framebuffer (fb_mirror) capturado da USB.
+//
+// Uso: mirror_decode [--pbm DIR] [--ascii] captura.bin
+//
+// A captura é o fluxo bruto da porta serial (por exemplo
+// `cat /dev/ttyACM0 > captura.bin` depois de mandar 'm' para a placa); o texto
+// que divide o canal com os pacotes é ignorado. Reconstrói os quadros e
+// imprime, em CSV nome,valor, quadros, pacotes, erros de CRC, pacotes
+// perdidos e a taxa de compressão (bytes de quadros crus / bytes de pacotes).
+// --pbm grava cada quadro como DIR/frame_NNNNN.pbm e --ascii desenha o último
+// quadro no terminal.
+
+#include "fb_mirror.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static fb_mirror_decoder_t decoder;
+
+// Pixel (x, y) no layout do framebuffer: páginas de cada coluna consecutivas
+static bool frame_pixel(const uint8_t *frame, int x, int y) {
+    return frame[SSD1306_INDEX(x, y >> 3)] & (1 << (y & 7));
+}
+
+static void write_pbm(const char *dir, uint32_t index, const uint8_t *frame) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%05lu.pbm", dir, (unsigned long)index);
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "P1\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    for (int y = 0; y < SSD1306_HEIGHT; ++y) {
+        for (int x = 0; x < SSD1306_WIDTH; ++x)
+            fputc(frame_pixel(frame, x, y) ? '1' : '0', f);
+        fputc('\n', f);
+    }
+    fclose(f);
+}
+
+// Duas linhas de pixels por linha de texto
+static void print_ascii(const uint8_t *frame) {
+    for (int y = 0; y < SSD1306_HEIGHT; y += 2) {
+        for (int x = 0; x < SSD1306_WIDTH; ++x) {
+            bool top = frame_pixel(frame, x, y);
+            bool bottom = frame_pixel(frame, x, y + 1);
+            fputc(top && bottom ? '#' : top ? '"' : bottom ? '.' : ' ', stdout);
+        }
+        fputc('\n', stdout);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *pbm_dir = NULL;
+    const char *path = NULL;
+    bool ascii = false;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--pbm") && i + 1 < argc) pbm_dir = argv[++i];
+        else if (!strcmp(argv[i], "--ascii")) ascii = true;
+        else if (!path) path = argv[i];
+        else usage = true;
+    }
+    if (usage || !path) {
+        fprintf(stderr, "uso: %s [--pbm DIR] [--ascii] captura.bin\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+
+    fb_mirror_decoder_init(&decoder);
+    uint64_t total = 0;
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        total++;
+        if (fb_mirror_decode(&decoder, (uint8_t)c) && pbm_dir)
+            write_pbm(pbm_dir, decoder.frames, decoder.frame);
+    }
+    if (f != stdin) fclose(f);
+
+    uint64_t raw = (uint64_t)decoder.frames * SSD1306_FB_SIZE;
+    printf("frames,%lu\n", (unsigned long)decoder.frames);
+    printf("packets,%lu\n", (unsigned long)decoder.packets);
+    printf("crc_errors,%lu\n", (unsigned long)decoder.crc_errors);
+    printf("lost_packets,%lu\n", (unsigned long)decoder.lost_packets);
+    printf("stream_bytes,%llu\n", (unsigned long long)decoder.bytes_in);
+    printf("other_bytes,%llu\n", (unsigned long long)(total - decoder.bytes_in));
+    printf("raw_bytes,%llu\n", (unsigned long long)raw);
+    printf("bytes_per_frame,%.1f\n", decoder.frames ? (double)decoder.bytes_in / decoder.frames : 0.0);
+    printf("compression_ratio,%.1f\n", decoder.bytes_in ? (double)raw / decoder.bytes_in : 0.0);
+
+    if (ascii && decoder.frames)
+        print_ascii(decoder.frame);
+    return 0;
+}
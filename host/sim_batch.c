@@ -0,0 +1,247 @@
+// Simulador em lote das regras do jogo, sem display, para ajustar a dificuldade.
+//
+// Uso: sim_batch [--games N] [--threads T] [--seed S]
+//                [--radius R] [--max-misses M] [--win-score W]
+//                [--sigma PX] [--fitts-a MS] [--fitts-b MS] [--json]
+//
+// As threads reservam blocos de partidas; cada partida tem seu próprio game_t
+// e geradores próprios (alvos e jogador) semeados pelo índice da partida e
+// pela semente global, então o resultado não depende do número de threads.
+// O jogador é estocástico: leva o tempo da lei de Fitts para chegar ao alvo
+// e clica com um erro gaussiano de sigma pixels em cada eixo. Cada clique
+// passa por game_click, então raio de acerto, limite de erros e placar de
+// vitória são os do jogo.
+//
+// Saída: taxa de vitória, cliques por acerto e a distribuição do tempo até a
+// vitória (média e percentis), em CSV nome,valor ou --json.
+
+#include "game.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 256
+#define TIME_BUCKET_MS 100       // Resolução do histograma do tempo de vitória
+#define TIME_BUCKETS 6000        // Até 10 minutos; acima disso cai no último
+#define GAMES_PER_CHUNK 1024     // Partidas reservadas por vez por cada thread
+
+typedef struct {
+  game_rules_t rules;
+  double sigma_px;
+  double fitts_a_ms, fitts_b_ms;
+  uint64_t seed;
+  uint64_t games;
+} sim_config_t;
+
+typedef struct {
+  uint64_t games, wins;
+  uint64_t clicks, hits;
+  double win_time_ms;
+  uint64_t win_time_hist[TIME_BUCKETS];
+} sim_stats_t;
+
+typedef struct {
+  pthread_t thread;
+  const sim_config_t *config;
+  sim_stats_t stats;
+} sim_worker_t;
+
+static sim_config_t config = {
+  .rules = {GAME_HIT_RADIUS, GAME_MAX_MISSES, GAME_WIN_SCORE},
+  .sigma_px = 1.5,
+  .fitts_a_ms = 200,
+  .fitts_b_ms = 150,
+  .seed = 1,
+  .games = 1000000,
+};
+
+// Próxima partida a simular, compartilhada entre as threads
+static uint64_t next_game = 0;
+
+// splitmix64: semente independente por partida a partir do índice
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniforme em (0, 1]
+static double uniform(uint64_t *state) {
+    return ((splitmix64(state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// Normal padrão (Box-Muller)
+static double gaussian(uint64_t *state) {
+    double u1 = uniform(state);
+    double u2 = uniform(state);
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+static int clamp_coord(long value, int limit) {
+    if (value < 0) return 0;
+    if (value >= limit) return limit - 1;
+    return (int)value;
+}
+
+// Uma partida completa, do reinício até a vitória ou derrota
+static void sim_game(const sim_config_t *cfg, uint64_t index, sim_stats_t *stats) {
+    uint64_t rng = cfg->seed ^ (index * 0xD1B54A32D192ED03ull);
+    game_t game;
+    game_init(&game);
+    game.rules = cfg->rules;
+    game_seed(&game, (uint32_t)splitmix64(&rng));
+    game_reset(&game);
+
+    double width = 2.0 * cfg->rules.hit_radius - 1;
+    double elapsed_ms = 0;
+    bool ended = false;
+    while (!ended) {
+        double dx = game.target_x - game.cursor_x;
+        double dy = game.target_y - game.cursor_y;
+        double distance = sqrt(dx * dx + dy * dy);
+        elapsed_ms += cfg->fitts_a_ms + cfg->fitts_b_ms * log2(1.0 + distance / width);
+
+        long x = lround(game.target_x + cfg->sigma_px * gaussian(&rng));
+        long y = lround(game.target_y + cfg->sigma_px * gaussian(&rng));
+        game_set_cursor(&game, clamp_coord(x, GAME_WIDTH), clamp_coord(y, GAME_HEIGHT));
+
+        uint32_t hits = game.hit_count;
+        ended = game_click(&game);
+        stats->clicks++;
+        stats->hits += game.hit_count - hits;
+    }
+
+    stats->games++;
+    if (game.victory) {
+        stats->wins++;
+        stats->win_time_ms += elapsed_ms;
+        size_t bucket = (size_t)(elapsed_ms / TIME_BUCKET_MS);
+        stats->win_time_hist[bucket < TIME_BUCKETS ? bucket : TIME_BUCKETS - 1]++;
+    }
+}
+
+static void *sim_worker(void *arg) {
+    sim_worker_t *worker = arg;
+    const sim_config_t *cfg = worker->config;
+    while (1) {
+        uint64_t first = __atomic_fetch_add(&next_game, GAMES_PER_CHUNK, __ATOMIC_RELAXED);
+        if (first >= cfg->games) break;
+        uint64_t last = first + GAMES_PER_CHUNK < cfg->games ? first + GAMES_PER_CHUNK : cfg->games;
+        for (uint64_t i = first; i < last; ++i)
+            sim_game(cfg, i, &worker->stats);
+    }
+    return NULL;
+}
+
+static void merge_stats(sim_stats_t *total, const sim_stats_t *part) {
+    total->games += part->games;
+    total->wins += part->wins;
+    total->clicks += part->clicks;
+    total->hits += part->hits;
+    total->win_time_ms += part->win_time_ms;
+    for (size_t i = 0; i < TIME_BUCKETS; ++i)
+        total->win_time_hist[i] += part->win_time_hist[i];
+}
+
+// Percentil do tempo de vitória, em segundos (limite superior do bucket)
+static double win_time_percentile(const sim_stats_t *stats, double fraction) {
+    uint64_t rank = (uint64_t)ceil(fraction * stats->wins);
+    uint64_t seen = 0;
+    if (rank == 0) rank = 1;
+    for (size_t i = 0; i < TIME_BUCKETS; ++i) {
+        seen += stats->win_time_hist[i];
+        if (seen >= rank) return (i + 1) * TIME_BUCKET_MS / 1000.0;
+    }
+    return 0;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int usage(const char *argv0) {
+    fprintf(stderr, "uso: %s [--games N] [--threads T] [--seed S] [--radius R] [--max-misses M]\n"
+                    "       [--win-score W] [--sigma PX] [--fitts-a MS] [--fitts-b MS] [--json]\n", argv0);
+    return 2;
+}
+
+// Regras cabem em uint8_t: só aceita um número inteiro de 1 a 255
+static bool parse_rule(const char *text, uint8_t *out) {
+    char *end;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end || value < 1 || value > 255) return false;
+    *out = (uint8_t)value;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc, valid = true;
+        if (!strcmp(argv[i], "--json")) json = true;
+        else if (!strcmp(argv[i], "--games") && has_value) config.games = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--threads") && has_value) threads = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && has_value) config.seed = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--radius") && has_value) valid = parse_rule(argv[++i], &config.rules.hit_radius);
+        else if (!strcmp(argv[i], "--max-misses") && has_value) valid = parse_rule(argv[++i], &config.rules.max_misses);
+        else if (!strcmp(argv[i], "--win-score") && has_value) valid = parse_rule(argv[++i], &config.rules.win_score);
+        else if (!strcmp(argv[i], "--sigma") && has_value) config.sigma_px = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--fitts-a") && has_value) config.fitts_a_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--fitts-b") && has_value) config.fitts_b_ms = atof(argv[++i]);
+        else return usage(argv[0]);
+        if (!valid) return usage(argv[0]);
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    static sim_worker_t workers[MAX_THREADS];
+    double start = now_s();
+    for (long t = 0; t < threads; ++t) {
+        workers[t].config = &config;
+        pthread_create(&workers[t].thread, NULL, sim_worker, &workers[t]);
+    }
+
+    static sim_stats_t total;
+    for (long t = 0; t < threads; ++t) {
+        pthread_join(workers[t].thread, NULL);
+        merge_stats(&total, &workers[t].stats);
+    }
+    double seconds = now_s() - start;
+
+    double win_rate = total.games ? (double)total.wins / total.games : 0;
+    double clicks_per_hit = total.hits ? (double)total.clicks / total.hits : 0;
+    double mean_win_s = total.wins ? total.win_time_ms / total.wins / 1000.0 : 0;
+    double p10 = win_time_percentile(&total, 0.10);
+    double p50 = win_time_percentile(&total, 0.50);
+    double p90 = win_time_percentile(&total, 0.90);
+
+    if (json) {
+        printf("{\"games\": %llu, \"threads\": %ld, \"radius\": %u, \"max_misses\": %u, \"win_score\": %u,\n",
+               (unsigned long long)total.games, threads, config.rules.hit_radius,
+               config.rules.max_misses, config.rules.win_score);
+        printf(" \"win_rate\": %.5f, \"clicks_per_hit\": %.4f,\n", win_rate, clicks_per_hit);
+        printf(" \"win_time_s\": {\"mean\": %.2f, \"p10\": %.1f, \"p50\": %.1f, \"p90\": %.1f},\n",
+               mean_win_s, p10, p50, p90);
+        printf(" \"games_per_s\": %.0f}\n", total.games / seconds);
+    } else {
+        printf("games,%llu\n", (unsigned long long)total.games);
+        printf("threads,%ld\n", threads);
+        printf("radius,%u\nmax_misses,%u\nwin_score,%u\n", config.rules.hit_radius,
+               config.rules.max_misses, config.rules.win_score);
+        printf("win_rate,%.5f\n", win_rate);
+        printf("clicks_per_hit,%.4f\n", clicks_per_hit);
+        printf("win_time_mean_s,%.2f\n", mean_win_s);
+        printf("win_time_p10_s,%.1f\nwin_time_p50_s,%.1f\nwin_time_p90_s,%.1f\n", p10, p50, p90);
+        printf("games_per_s,%.0f\n", total.games / seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Verificações dos testes de host: cada falha é impressa e contada, e o
+// teste termina com check_result() (código 1 se algo falhou, para o ctest).
+
+static int check_failures = 0;
+
+#define CHECK(cond, ...)                                        \
+  do {                                                          \
+    if (!(cond)) {                                              \
+      fprintf(stderr, "%s:%d: falhou: ", __FILE__, __LINE__);   \
+      fprintf(stderr, __VA_ARGS__);                             \
+      fputc('\n', stderr);                                      \
+      check_failures++;                                         \
+    }                                                           \
+  } while (0)
+
+// xorshift32 para as entradas sorteadas; a semente fixa torna o teste repetível
+static uint32_t check_rng = 1;
+
+static inline uint32_t check_random(void) {
+  check_rng ^= check_rng << 13;
+  check_rng ^= check_rng >> 17;
+  check_rng ^= check_rng << 5;
+  return check_rng;
+}
+
+static inline int check_result(const char *name) {
+  if (check_failures)
+    fprintf(stderr, "%s: %d falha(s)\n", name, check_failures);
+  else
+    printf("%s: ok\n", name);
+  return check_failures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,317 @@
+// Debounce dos botões (button_debounce.pio) simulado ciclo a ciclo: o
+// programa é lido do próprio .pio, montado num subconjunto de instruções
+// (jmp, mov e in) e executado com o OSR, o X e o autopush configurados como
+// em button_debounce_program_init. O pino segue uma forma de onda sorteada,
+// com repiques mais curtos que o tempo de integração antes de cada troca
+// real e pulsos soltos no meio dos níveis estáveis. Confere:
+//   - 4 ciclos entre amostras (jmp x--) em todos os caminhos;
+//   - uma palavra por troca real, alternando pressionado e solto;
+//   - nenhuma palavra para os repiques;
+//   - o início do nível estável decodificado como em inc/buttons.c, a menos
+//     de 2 µs do instante real.
+
+#include "check.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CYCLES_PER_SAMPLE 4  // BUTTON_DEBOUNCE_CYCLES_PER_SAMPLE, uma amostra por µs
+#define MAX_INSTR 32
+#define MAX_LABELS 32
+#define TRANSITIONS 60
+
+typedef enum { OP_JMP, OP_MOV, OP_IN } op_t;
+typedef enum { COND_ALWAYS, COND_X_DEC, COND_Y_DEC, COND_PIN } cond_t;
+typedef enum { REG_X, REG_Y, REG_OSR, REG_NULL, REG_NOT_NULL } reg_t;
+
+typedef struct {
+    op_t op;
+    cond_t cond;
+    reg_t dst, src;
+    int target;  // Índice da instrução (jmp)
+    int bits;    // Bits deslocados (in)
+    int delay;
+    char target_name[32];
+} instr_t;
+
+static instr_t prog[MAX_INSTR];
+static int prog_len, wrap_target = -1, wrap = -1;
+static struct {
+    char name[32];
+    int at;
+} labels[MAX_LABELS];
+static int label_count;
+
+static char *trim(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) *--end = 0;
+    return s;
+}
+
+static bool parse_reg(const char *s, reg_t *reg) {
+    static const struct {
+        const char *name;
+        reg_t reg;
+    } regs[] = {{"x", REG_X}, {"y", REG_Y}, {"osr", REG_OSR}, {"null", REG_NULL}, {"~null", REG_NOT_NULL},
+                {"!null", REG_NOT_NULL}};
+    for (size_t i = 0; i < sizeof(regs) / sizeof(regs[0]); ++i) {
+        if (!strcmp(s, regs[i].name)) {
+            *reg = regs[i].reg;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Monta uma linha já sem comentário nem rótulo; false se fugir do subconjunto
+static bool parse_instr(char *line, instr_t *in) {
+    memset(in, 0, sizeof(*in));
+    char *delay = strchr(line, '[');
+    if (delay) {
+        in->delay = atoi(delay + 1);
+        *delay = 0;
+    }
+    // Vírgulas só separam operandos: "jmp x-- alvo" e "mov y, osr"
+    for (char *c = line; *c; ++c) {
+        if (*c == ',') *c = ' ';
+    }
+    char op[16], a[32], b[32];
+    int n = sscanf(line, "%15s %31s %31s", op, a, b);
+    if (n < 2) return false;
+
+    if (!strcmp(op, "jmp")) {
+        in->op = OP_JMP;
+        const char *target = a;
+        if (n == 3) {
+            target = b;
+            if (!strcmp(a, "x--")) in->cond = COND_X_DEC;
+            else if (!strcmp(a, "y--")) in->cond = COND_Y_DEC;
+            else if (!strcmp(a, "pin")) in->cond = COND_PIN;
+            else return false;
+        }
+        snprintf(in->target_name, sizeof(in->target_name), "%s", target);
+        return true;
+    }
+    if (n != 3) return false;
+    if (!strcmp(op, "mov")) {
+        in->op = OP_MOV;
+        return parse_reg(a, &in->dst) && (in->dst == REG_X || in->dst == REG_Y) && parse_reg(b, &in->src);
+    }
+    if (!strcmp(op, "in")) {
+        in->op = OP_IN;
+        in->bits = atoi(b);
+        return parse_reg(a, &in->src) && in->src != REG_OSR && in->src != REG_NOT_NULL && in->bits >= 1 &&
+               in->bits <= 32;
+    }
+    return false;
+}
+
+static bool load_program(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char buf[256];
+    bool in_sdk = false, ok = true;
+    int lineno = 0;
+    while (ok && fgets(buf, sizeof(buf), f)) {
+        lineno++;
+        char *line = trim(buf);
+        if (in_sdk) {
+            in_sdk = strncmp(line, "%}", 2) != 0;
+            continue;
+        }
+        if (line[0] == '%') {
+            in_sdk = true;
+            continue;
+        }
+        char *comment = strchr(line, ';');
+        if (comment) *comment = 0;
+        line = trim(line);
+        if (!*line) continue;
+
+        if (!strcmp(line, ".wrap_target")) wrap_target = prog_len;
+        else if (!strcmp(line, ".wrap")) wrap = prog_len - 1;
+        else if (line[0] == '.') continue;  // .program, .pio_version, ...
+        else if (line[strlen(line) - 1] == ':') {
+            line[strlen(line) - 1] = 0;
+            if (label_count == MAX_LABELS) return false;
+            snprintf(labels[label_count].name, sizeof(labels[0].name), "%s", line);
+            labels[label_count++].at = prog_len;
+        } else {
+            ok = prog_len < MAX_INSTR && parse_instr(line, &prog[prog_len++]);
+            CHECK(ok, "%s:%d: instrução fora do subconjunto simulado: %s", path, lineno, line);
+        }
+    }
+    fclose(f);
+    if (!ok) return false;
+
+    for (int i = 0; i < prog_len; ++i) {
+        if (prog[i].op != OP_JMP) continue;
+        prog[i].target = -1;
+        for (int k = 0; k < label_count; ++k) {
+            if (!strcmp(labels[k].name, prog[i].target_name)) prog[i].target = labels[k].at;
+        }
+        CHECK(prog[i].target >= 0, "rótulo %s não encontrado", prog[i].target_name);
+    }
+    if (wrap_target < 0) wrap_target = 0;
+    if (wrap < 0) wrap = prog_len - 1;
+    return !check_failures && prog_len > 0;
+}
+
+// Forma de onda do pino: níveis a partir de cada ciclo, 1 = solto (pull-up)
+typedef struct {
+    uint64_t at;
+    bool level;
+} edge_t;
+
+static edge_t *wave;
+static size_t wave_len, wave_cap;
+
+// Troca real: ciclo em que o nível estável começa
+static uint64_t real_at[TRANSITIONS];
+
+static void wave_push(uint64_t at, bool level) {
+    if (wave_len == wave_cap) {
+        wave_cap = wave_cap ? 2 * wave_cap : 256;
+        wave = realloc(wave, wave_cap * sizeof(*wave));
+        if (!wave) abort();
+    }
+    wave[wave_len++] = (edge_t){at, level};
+}
+
+static uint64_t random_between(uint64_t lo, uint64_t hi) {
+    return lo + ((uint64_t)check_random() << 32 | check_random()) % (hi - lo + 1);
+}
+
+// Segmentos de repique com pelo menos uma amostra (o nível oposto zera a
+// integração) e no máximo N - 1 amostras (N + 1 validam a troca)
+static uint64_t build_wave(uint32_t debounce_us) {
+    uint64_t stable = (uint64_t)CYCLES_PER_SAMPLE * debounce_us;
+    uint64_t bounce_max = debounce_us >= 3 ? (uint64_t)CYCLES_PER_SAMPLE * (debounce_us - 2) : 0;
+    uint64_t t = 0;
+    bool level = true;
+    wave_len = 0;
+    wave_push(0, true);
+
+    for (int k = 0; k < TRANSITIONS; ++k) {
+        // Nível estável, às vezes com um pulso solto no meio
+        t += stable + random_between(8, 3 * stable);
+        if (bounce_max >= CYCLES_PER_SAMPLE && check_random() % 3 == 0) {
+            wave_push(t, !level);
+            t += random_between(CYCLES_PER_SAMPLE, bounce_max);
+            wave_push(t, level);
+            t += stable + random_between(8, stable);
+        }
+        // Repiques antes da troca
+        if (bounce_max >= CYCLES_PER_SAMPLE) {
+            for (int b = check_random() % 6; b > 0; --b) {
+                wave_push(t, !level);
+                t += random_between(CYCLES_PER_SAMPLE, bounce_max);
+                wave_push(t, level);
+                t += random_between(CYCLES_PER_SAMPLE, bounce_max);
+            }
+        }
+        level = !level;
+        wave_push(t, level);
+        real_at[k] = t;
+    }
+    return t + 3 * stable;
+}
+
+static bool pin_at(uint64_t cycle, size_t *pos) {
+    while (*pos + 1 < wave_len && wave[*pos + 1].at <= cycle) (*pos)++;
+    return wave[*pos].level;
+}
+
+static void run(uint32_t debounce_us) {
+    uint64_t end = build_wave(debounce_us);
+    uint32_t osr = debounce_us - 1, x = 0xFFFFFFFFu, y = 0, isr = 0;
+    int isr_count = 0, pc = wrap_target, found = 0;
+    uint64_t last_sample = 0;
+    bool sampled = false;
+    size_t wave_pos = 0;
+    uint32_t start_us = 0x9E3779B9u;  // time_us_32 na partida das máquinas
+
+    for (uint64_t cycle = 0; cycle < end && !check_failures;) {
+        const instr_t *in = &prog[pc];
+        int next = pc == wrap ? wrap_target : pc + 1;
+        switch (in->op) {
+            case OP_JMP: {
+                bool take = true;
+                if (in->cond == COND_X_DEC) {
+                    CHECK(!sampled || cycle - last_sample == CYCLES_PER_SAMPLE,
+                          "debounce %u: amostras a %llu ciclos no ciclo %llu", debounce_us,
+                          (unsigned long long)(cycle - last_sample), (unsigned long long)cycle);
+                    sampled = true;
+                    last_sample = cycle;
+                    take = x-- != 0;
+                } else if (in->cond == COND_Y_DEC) {
+                    take = y-- != 0;
+                } else if (in->cond == COND_PIN) {
+                    take = pin_at(cycle, &wave_pos);
+                }
+                if (take) next = in->target;
+                break;
+            }
+            case OP_MOV: {
+                uint32_t v = in->src == REG_X ? x : in->src == REG_Y ? y : in->src == REG_OSR ? osr
+                           : in->src == REG_NULL ? 0 : 0xFFFFFFFFu;
+                if (in->dst == REG_X) x = v;
+                else y = v;
+                break;
+            }
+            case OP_IN: {
+                uint32_t v = in->src == REG_X ? x : in->src == REG_Y ? y : 0;
+                uint32_t mask = in->bits == 32 ? 0xFFFFFFFFu : (1u << in->bits) - 1;
+                isr = in->bits == 32 ? v : isr << in->bits | (v & mask);
+                isr_count += in->bits;
+                if (isr_count < 32) break;
+
+                // Autopush: decodifica como buttons_irq_handler
+                uint32_t word = isr, now = start_us + (uint32_t)(cycle / CYCLES_PER_SAMPLE) + 3;
+                isr = 0;
+                isr_count = 0;
+                uint32_t confirm_us = start_us + (0x7FFFFFFFu - (word >> 1));
+                confirm_us = now - ((now - confirm_us) & 0x7FFFFFFFu);
+                uint32_t edge_us = confirm_us - debounce_us;
+                bool pressed = !(word & 1);
+
+                CHECK(found < TRANSITIONS, "debounce %u: palavra a mais no ciclo %llu", debounce_us,
+                      (unsigned long long)cycle);
+                if (found >= TRANSITIONS) break;
+                CHECK(pressed == !(found & 1), "debounce %u: troca %d com nível %s", debounce_us, found,
+                      pressed ? "pressionado" : "solto");
+                // Erro em quartos de µs: a primeira amostra estável cai até 2 µs depois
+                int64_t err = (int64_t)(edge_us - start_us) * CYCLES_PER_SAMPLE - (int64_t)real_at[found];
+                CHECK(err >= -CYCLES_PER_SAMPLE && err <= 2 * CYCLES_PER_SAMPLE,
+                      "debounce %u: troca %d em %lld ciclos, decodificada com erro de %lld", debounce_us, found,
+                      (long long)real_at[found], (long long)err);
+                found++;
+                break;
+            }
+        }
+        cycle += 1 + in->delay;
+        pc = next;
+    }
+    CHECK(found == TRANSITIONS, "debounce %u: %d palavras para %d trocas", debounce_us, found, TRANSITIONS);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s button_debounce.pio\n", argv[0]);
+        return 2;
+    }
+    if (!load_program(argv[1])) return check_result("button_debounce");
+
+    static const uint32_t debounces[] = {1, 2, 3, 10, 250, 10000};
+    for (size_t i = 0; i < sizeof(debounces) / sizeof(debounces[0]) && !check_failures; ++i)
+        run(debounces[i]);
+    free(wave);
+    return check_result("button_debounce");
+}
@@ -0,0 +1,114 @@
+// Conjunto de entidades (inc/entities.c): teste de acerto pela grade contra
+// uma varredura linear, desenho dos sprites contra o desenho pixel a pixel
+// e invariantes da física (centros dentro dos limites, grade coerente com as
+// posições), com populações sorteadas de 1 a ENTITIES_MAX ao longo de
+// vários passos.
+
+#include "entities.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+
+static entities_t ents;
+static ssd1306_t fast, ref;
+
+// Referência: alvo à menor distância (Chebyshev) menor que o raio, varrendo todos
+static int linear_hit_dist(uint8_t x, uint8_t y, uint8_t radius) {
+    if (radius > ENTITY_MAX_RADIUS) radius = ENTITY_MAX_RADIUS;
+    int best = radius;
+    for (uint8_t i = 0; i < ents.count; ++i) {
+        if (ents.kind[i] != ENTITY_TARGET) continue;
+        int dx = abs(ents.px[i] - x), dy = abs(ents.py[i] - y);
+        int dist = dx > dy ? dx : dy;
+        if (dist < best) best = dist;
+    }
+    return best < radius ? best : -1;
+}
+
+static int hit_dist(int i, uint8_t x, uint8_t y) {
+    if (i == ENTITY_NONE) return -1;
+    CHECK(ents.kind[i] == ENTITY_TARGET, "acerto num obstáculo");
+    int dx = abs(ents.px[i] - x), dy = abs(ents.py[i] - y);
+    return dx > dy ? dx : dy;
+}
+
+// Sprites pixel a pixel: alvo 3x3 cheio, obstáculo 5x5 vazado
+static void ref_render(void) {
+    for (uint8_t i = 0; i < ents.count; ++i) {
+        int half = ents.kind[i] == ENTITY_TARGET ? 1 : 2;
+        for (int dx = -half; dx <= half; ++dx) {
+            for (int dy = -half; dy <= half; ++dy) {
+                bool edge = abs(dx) == half || abs(dy) == half;
+                if (ents.kind[i] == ENTITY_TARGET || edge) ssd1306_pixel(&ref, ents.px[i] + dx, ents.py[i] + dy, true);
+            }
+        }
+    }
+}
+
+static void check_state(int round, int step) {
+    // Sprites inteiros dentro da tela, a um pixel da borda
+    for (uint8_t i = 0; i < ents.count; ++i) {
+        int half = ents.kind[i] == ENTITY_TARGET ? 1 : 2;
+        CHECK(ents.px[i] > half && ents.px[i] < SSD1306_WIDTH - 1 - half && ents.py[i] > half &&
+                  ents.py[i] < SSD1306_HEIGHT - 1 - half,
+              "rodada %d passo %d: entidade %u em (%u, %u)", round, step, i, ents.px[i], ents.py[i]);
+        CHECK(ents.px[i] == ents.x[i] >> ENTITY_FRAC && ents.py[i] == ents.y[i] >> ENTITY_FRAC,
+              "rodada %d passo %d: pixel da entidade %u desatualizado", round, step, i);
+    }
+
+    // Grade: cada entidade uma vez, na célula do próprio centro
+    uint8_t seen[ENTITIES_MAX] = {0};
+    CHECK(ents.cell_start[0] == 0 && ents.cell_start[ENTITY_GRID_CELLS] == ents.count,
+          "rodada %d passo %d: grade com %u itens", round, step, ents.cell_start[ENTITY_GRID_CELLS]);
+    for (int c = 0; c < ENTITY_GRID_CELLS; ++c) {
+        for (int k = ents.cell_start[c]; k < ents.cell_start[c + 1]; ++k) {
+            uint8_t i = ents.cell_items[k];
+            int cell = (ents.py[i] >> ENTITY_CELL_SHIFT) * ENTITY_GRID_W + (ents.px[i] >> ENTITY_CELL_SHIFT);
+            CHECK(i < ents.count && cell == c && !seen[i]++, "rodada %d passo %d: entidade %u na célula %d", round,
+                  step, i, c);
+        }
+    }
+
+    // Acerto pela grade igual ao da varredura, inclusive com raio acima do limite
+    for (int k = 0; k < 256; ++k) {
+        uint8_t x = check_random() % SSD1306_WIDTH, y = check_random() % SSD1306_HEIGHT;
+        uint8_t radius = 1 + check_random() % (ENTITY_MAX_RADIUS + 4);
+        int grid = hit_dist(entities_hit(&ents, x, y, radius), x, y);
+        int linear = linear_hit_dist(x, y, radius);
+        CHECK(grid == linear, "rodada %d passo %d: acerto em (%u, %u) raio %u a %d, varredura %d", round, step, x, y,
+              radius, grid, linear);
+    }
+
+    // Desenho: framebuffer com fundo sorteado, sprites aplicados por OR
+    for (int i = 0; i < SSD1306_FB_SIZE; ++i)
+        fast.ram_buffer[i] = ref.ram_buffer[i] = check_random() & check_random();
+    entities_render(&ents, &fast);
+    ref_render();
+    CHECK(!memcmp(fast.ram_buffer, ref.ram_buffer, SSD1306_FB_SIZE), "rodada %d passo %d: desenho diverge", round,
+          step);
+}
+
+int main(void) {
+    for (int round = 0; round < 200 && !check_failures; ++round) {
+        entities_init(&ents);
+        int count = 1 + check_random() % ENTITIES_MAX;
+        for (int i = 0; i < count; ++i) {
+            entity_kind_t kind = check_random() % 4 == 3 ? ENTITY_OBSTACLE : ENTITY_TARGET;
+            int16_t speed = kind == ENTITY_OBSTACLE ? ENTITY_ONE / 4 : 2 * ENTITY_ONE;
+            CHECK(entities_spawn(&ents, kind, check_random() % SSD1306_WIDTH, check_random() % SSD1306_HEIGHT,
+                                 (int16_t)(check_random() % (2 * speed + 1)) - speed,
+                                 (int16_t)(check_random() % (2 * speed + 1)) - speed) == i,
+                  "spawn %d", i);
+        }
+        CHECK(count < ENTITIES_MAX || entities_spawn(&ents, ENTITY_TARGET, 10, 10, 0, 0) == ENTITY_NONE,
+              "spawn além de ENTITIES_MAX");
+
+        for (int step = 0; step < 50 && !check_failures; ++step) {
+            entities_step(&ents);
+            // De vez em quando some uma entidade; os índices continuam densos
+            if (ents.count > 1 && check_random() % 8 == 0) entities_remove(&ents, check_random() % ents.count);
+            check_state(round, step);
+        }
+    }
+    return check_result("entities");
+}
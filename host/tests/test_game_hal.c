@@ -0,0 +1,226 @@
+// Máquina de estados do jogo (game_t) e driver SSD1306 sobre a HAL de host
+// que registra o I2C. Confere as transições do jogo (acerto no limite do
+// raio, derrota por erros, vitória, pausa, entradas ignoradas no fim e
+// reinício) e os bytes que o driver emite: sequência de configuração,
+// comandos avulsos e as janelas do flush parcial. Por fim joga partidas
+// inteiras desenhando com game_view e decodifica cada flush num modelo da
+// RAM do display, que tem de terminar igual ao framebuffer.
+
+#include "game.h"
+#include "game_render.h"
+#include "ssd1306.h"
+#include "hal_host.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+
+static ssd1306_t ssd;
+static game_t game;
+static game_view_t view;
+static uint8_t display[SSD1306_FB_SIZE];  // RAM do display reconstruída dos bytes
+
+// Bytes registrados desde o último hal_host_i2c_clear iguais a expected
+static bool i2c_equals(const uint8_t *expected, size_t len) {
+    size_t log_len;
+    const uint8_t *log = hal_host_i2c_log(&log_len);
+    return log_len == len && !memcmp(log, expected, len);
+}
+
+// Aplica ao modelo do display os bytes de um flush: janelas com o byte de
+// controle 0x00, COL_ADDR e PAGE_ADDR, seguidas de 0x40 e dos dados na ordem
+// do endereçamento vertical. Retorna o número de janelas, ou -1 se o fluxo
+// não segue esse formato.
+static int decode_flush(void) {
+    size_t len, pos = 0;
+    const uint8_t *log = hal_host_i2c_log(&len);
+    int windows = 0;
+    while (pos < len) {
+        if (pos + 8 > len || log[pos] != 0x00 || log[pos + 1] != SET_COL_ADDR || log[pos + 4] != SET_PAGE_ADDR ||
+            log[pos + 7] != 0x40)
+            return -1;
+        uint8_t x0 = log[pos + 2], x1 = log[pos + 3], p0 = log[pos + 5], p1 = log[pos + 6];
+        if (x0 > x1 || x1 >= SSD1306_WIDTH || p0 > p1 || p1 >= SSD1306_PAGES) return -1;
+        pos += 8;
+        size_t count = (size_t)(x1 - x0 + 1) * (p1 - p0 + 1);
+        if (pos + count > len) return -1;
+        for (int x = x0; x <= x1; ++x)
+            for (int p = p0; p <= p1; ++p)
+                display[SSD1306_INDEX(x, p)] = log[pos++];
+        windows++;
+    }
+    return windows;
+}
+
+static int flush(void) {
+    hal_host_i2c_clear();
+    ssd1306_send_data(&ssd);
+    return decode_flush();
+}
+
+static void test_driver(void) {
+    hal_host_reset();
+    ssd1306_init(&ssd, false, 0x3C, NULL);
+    ssd1306_config(&ssd);
+
+    // Configuração: um comando por transação, cada um com o byte de controle 0x80
+    static const uint8_t config[] = {
+        SET_DISP, SET_MEM_ADDR, 0x01, SET_DISP_START_LINE, SET_SEG_REMAP | 0x01, SET_MUX_RATIO, SSD1306_HEIGHT - 1,
+        SET_COM_OUT_DIR | 0x08, SET_DISP_OFFSET, 0x00, SET_COM_PIN_CFG, 0x12, SET_DISP_CLK_DIV, 0x80,
+        SET_PRECHARGE, 0xF1, SET_VCOM_DESEL, 0x30, SET_CONTRAST, 0xFF, SET_ENTIRE_ON, SET_NORM_INV,
+        SET_CHARGE_PUMP, 0x14, SET_DISP | 0x01,
+    };
+    uint8_t expected[2 * sizeof(config)];
+    for (size_t i = 0; i < sizeof(config); ++i) {
+        expected[2 * i] = 0x80;
+        expected[2 * i + 1] = config[i];
+    }
+    CHECK(i2c_equals(expected, sizeof(expected)), "sequência de configuração");
+    CHECK(hal_host_i2c_transactions() == sizeof(config), "%zu transações na configuração",
+          hal_host_i2c_transactions());
+
+    hal_host_i2c_clear();
+    ssd1306_contrast(&ssd, 0x42);
+    ssd1306_invert(&ssd, true);
+    static const uint8_t commands[] = {0x00, SET_CONTRAST, 0x42, 0x80, SET_NORM_INV | 0x01};
+    CHECK(i2c_equals(commands, sizeof(commands)), "contraste e inversão");
+    CHECK(hal_host_i2c_transactions() == 2, "contraste e inversão em duas transações");
+
+    // Primeiro flush: a tela inteira numa janela só
+    memset(display, 0xA5, sizeof(display));
+    ssd1306_fill(&ssd, false);
+    CHECK(flush() == 1, "primeiro flush não é uma janela");
+    CHECK(hal_host_i2c_bytes() == SSD1306_DMA_WORDS, "primeiro flush com %zu bytes", hal_host_i2c_bytes());
+    CHECK(!memcmp(display, ssd.ram_buffer, SSD1306_FB_SIZE), "display diferente do framebuffer");
+
+    // Sem mudanças, nada vai para o barramento
+    CHECK(flush() == 0 && hal_host_i2c_bytes() == 0, "flush sem mudanças enviou %zu bytes", hal_host_i2c_bytes());
+
+    // Um pixel: janela de uma coluna e uma página
+    ssd1306_pixel(&ssd, 10, 20, true);
+    static const uint8_t one_pixel[] = {0x00, SET_COL_ADDR, 10, 10, SET_PAGE_ADDR, 2, 2, 0x40, 1 << 4};
+    CHECK(flush() == 1 && i2c_equals(one_pixel, sizeof(one_pixel)), "flush de um pixel");
+
+    // Cantos opostos: duas janelas por página saem mais baratas que a envolvente
+    ssd1306_pixel(&ssd, 0, 0, true);
+    ssd1306_pixel(&ssd, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1, true);
+    static const uint8_t corners[] = {
+        0x00, SET_COL_ADDR, 0, 0, SET_PAGE_ADDR, 0, 0, 0x40, 0x01,
+        0x00, SET_COL_ADDR, SSD1306_WIDTH - 1, SSD1306_WIDTH - 1, SET_PAGE_ADDR, SSD1306_PAGES - 1,
+        SSD1306_PAGES - 1, 0x40, 0x80,
+    };
+    CHECK(flush() == 2 && i2c_equals(corners, sizeof(corners)), "flush dos cantos");
+    CHECK(hal_host_i2c_transactions() == 4, "cantos em %zu transações", hal_host_i2c_transactions());
+
+    // Mudanças vizinhas em páginas seguidas: uma janela envolvente
+    ssd1306_rect(&ssd, 12, 40, 6, 10, true, true);
+    CHECK(flush() == 1, "retângulo não saiu numa janela");
+    CHECK(!memcmp(display, ssd.ram_buffer, SSD1306_FB_SIZE), "display diferente do framebuffer");
+
+    // Invalidar força o quadro inteiro de novo
+    ssd1306_invalidate(&ssd);
+    CHECK(flush() == 1 && hal_host_i2c_bytes() == SSD1306_DMA_WORDS, "flush após invalidar");
+}
+
+static void test_rules(void) {
+    game_init(&game);
+    game_seed(&game, 7);
+    game_reset(&game);
+    CHECK(game_accepts_input(&game) && game.reset_count == 1, "partida nova não aceita entrada");
+    CHECK(game.target_x >= 2 && game.target_x < GAME_WIDTH - 2 && game.target_y >= 2 && game.target_y < GAME_HEIGHT - 2,
+          "alvo fora da área (%u, %u)", game.target_x, game.target_y);
+
+    // Limite do raio: |d| = raio - 1 acerta, |d| = raio erra
+    uint8_t tx = game.target_x, ty = game.target_y, r = game.rules.hit_radius;
+    game_set_cursor(&game, tx + r, ty);
+    game_click(&game);
+    CHECK(game.score == 0 && game.click_count == 1, "acerto com |dx| = raio");
+    game_set_cursor(&game, tx - (r - 1), ty + (r - 1));
+    game_click(&game);
+    CHECK(game.score == 1 && game.click_count == 0 && game.hit_count == 1, "erro com |dx| = |dy| = raio - 1");
+    CHECK(game.target_x != tx || game.target_y != ty, "alvo não mudou depois do acerto");
+
+    // Pausa: cliques ignorados
+    game_toggle_pause(&game);
+    CHECK(!game_accepts_input(&game) && !game_click(&game) && game.click_count == 0, "clique aceito em pausa");
+    game_toggle_pause(&game);
+
+    // Derrota: max_misses erros ainda jogam, o seguinte encerra
+    game_set_cursor(&game, (game.target_x + GAME_WIDTH / 2) % GAME_WIDTH, game.target_y);
+    for (int i = 0; i < game.rules.max_misses; ++i)
+        CHECK(!game_click(&game), "fim de jogo no erro %d", i + 1);
+    CHECK(game_click(&game) && game.game_over && !game.victory, "sem derrota após %u erros", game.click_count);
+    uint8_t clicks = game.click_count;
+    CHECK(!game_accepts_input(&game) && !game_click(&game) && game.click_count == clicks, "clique aceito no fim");
+
+    // Reinício: placar zerado, cursor no centro, contagem acumulada
+    game_reset(&game);
+    CHECK(game.score == 0 && game.click_count == 0 && !game.game_over && game.reset_count == 2 && game.hit_count == 1,
+          "reinício");
+    CHECK(game.cursor_x == GAME_WIDTH / 2 && game.cursor_y == GAME_HEIGHT / 2, "cursor fora do centro após reinício");
+
+    // Vitória no win_score-ésimo acerto
+    for (int i = 0; i < game.rules.win_score; ++i) {
+        game_set_cursor(&game, game.target_x, game.target_y);
+        bool over = game_click(&game);
+        CHECK(over == (i == game.rules.win_score - 1), "fim de jogo no acerto %d", i + 1);
+    }
+    CHECK(game.game_over && game.victory && game.score == game.rules.win_score, "sem vitória");
+
+    // Cursor recortado à tela
+    game_set_cursor(&game, 200, 200);
+    CHECK(game.cursor_x == GAME_WIDTH - 1 && game.cursor_y == GAME_HEIGHT - 1, "cursor não recortado");
+}
+
+// Partidas inteiras com um jogador que acerta metade das vezes. Um modelo
+// das regras acompanha o jogo; cada quadro vai ao display pelo flush parcial.
+static void test_games(void) {
+    hal_host_reset();
+    ssd1306_init(&ssd, false, 0x3C, NULL);
+    game_view_init(&view);
+    game_init(&game);
+    game_seed(&game, 12345);
+    game_reset(&game);
+
+    int victories = 0, defeats = 0;
+    uint8_t score = 0, misses = 0;
+    for (int step = 0; step < 20000 && !check_failures; ++step) {
+        if (game.game_over) {
+            game_reset(&game);
+            score = misses = 0;
+        } else {
+            bool aim = check_random() & 1;
+            uint8_t x = aim ? game.target_x : check_random() % GAME_WIDTH;
+            uint8_t y = aim ? game.target_y : check_random() % GAME_HEIGHT;
+            game_set_cursor(&game, x, y);
+            bool hit = abs(x - game.target_x) < game.rules.hit_radius && abs(y - game.target_y) < game.rules.hit_radius;
+            bool over = game_click(&game);
+            if (hit) {
+                score++;
+                misses = 0;
+            } else {
+                misses++;
+            }
+            bool lost = misses > game.rules.max_misses, won = score >= game.rules.win_score;
+            CHECK(game.score == score && game.click_count == misses, "placar %u/%u, esperado %u/%u", game.score,
+                  game.click_count, score, misses);
+            CHECK(over == (lost || won) && game.victory == won, "fim de jogo no passo %d", step);
+            victories += won;
+            defeats += lost;
+        }
+
+        game_snapshot_t snap;
+        game_snapshot(&game, &snap);
+        game_view_render(&view, &ssd, &snap);
+        CHECK(flush() >= 0, "flush mal formado no passo %d", step);
+        CHECK(!memcmp(display, ssd.ram_buffer, SSD1306_FB_SIZE), "display diferente do framebuffer no passo %d",
+              step);
+    }
+    CHECK(victories > 0 && defeats > 0, "%d vitórias e %d derrotas", victories, defeats);
+}
+
+int main(void) {
+    test_driver();
+    test_rules();
+    test_games();
+    return check_result("game_hal");
+}
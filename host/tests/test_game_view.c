@@ -0,0 +1,82 @@
+// Cena retida do HUD (game_view_render, sobre inc/scene.c) contra o
+// redesenho completo (game_render_hud e game_render_final): 200 mil quadros
+// sorteados, com o cursor andando aos poucos ou saltando (inclusive até as
+// bordas), alvo e placar mudando e telas finais no meio. Depois de cada
+// quadro os dois framebuffers têm de ser iguais pixel a pixel.
+
+#include "game_render.h"
+#include "game.h"
+#include "check.h"
+#include <string.h>
+
+#define FRAMES 200000
+
+static ssd1306_t retained, full;
+static game_view_t view;
+
+static uint8_t random_coord(int size) {
+    switch (check_random() % 8) {
+        case 0: return 0;
+        case 1: return size - 1;
+        case 2: return check_random() % 3;
+        case 3: return size - 1 - check_random() % 3;
+        default: return check_random() % size;
+    }
+}
+
+static uint8_t step_coord(uint8_t v, int size) {
+    int next = v + (int)(check_random() % 5) - 2;
+    return next < 0 ? 0 : next >= size ? size - 1 : next;
+}
+
+int main(void) {
+    game_view_init(&view);
+    game_snapshot_t snap = {
+        .cursor_x = GAME_WIDTH / 2, .cursor_y = GAME_HEIGHT / 2,
+        .target_x = GAME_WIDTH / 2, .target_y = GAME_HEIGHT / 2,
+        .playing = true,
+    };
+
+    for (long frame = 0; frame < FRAMES && !check_failures; ++frame) {
+        uint32_t r = check_random() % 100;
+        if (snap.game_over) {
+            // Tela final por alguns quadros, depois uma partida nova
+            if (r < 30) {
+                snap.game_over = false;
+                snap.score = snap.click_count = 0;
+                snap.cursor_x = GAME_WIDTH / 2;
+                snap.cursor_y = GAME_HEIGHT / 2;
+            }
+        } else if (r < 60) {
+            snap.cursor_x = step_coord(snap.cursor_x, GAME_WIDTH);
+            snap.cursor_y = step_coord(snap.cursor_y, GAME_HEIGHT);
+        } else if (r < 70) {
+            snap.cursor_x = random_coord(GAME_WIDTH);
+            snap.cursor_y = random_coord(GAME_HEIGHT);
+        } else if (r < 80) {
+            snap.score++;
+            snap.click_count = 0;
+            snap.target_x = random_coord(GAME_WIDTH);
+            snap.target_y = random_coord(GAME_HEIGHT);
+        } else if (r < 90) {
+            snap.click_count++;
+        } else if (r < 95) {
+            snap.score = check_random() & 0xFF;  // Números de 1 a 3 dígitos
+            snap.click_count = check_random() & 0xFF;
+        } else if (r < 97) {
+            snap.game_over = true;
+            snap.victory = check_random() & 1;
+        }
+        // Com r >= 97 o quadro repete o anterior: a cena não pode sujar nada
+
+        game_view_render(&view, &retained, &snap);
+        if (snap.game_over)
+            game_render_final(&full, snap.victory);
+        else
+            game_render_hud(&full, &snap);
+        CHECK(!memcmp(retained.ram_buffer, full.ram_buffer, SSD1306_FB_SIZE),
+              "quadro %ld difere (cursor %u,%u alvo %u,%u placar %u cliques %u fim %d)", frame, snap.cursor_x,
+              snap.cursor_y, snap.target_x, snap.target_y, snap.score, snap.click_count, snap.game_over);
+    }
+    return check_result("game_view");
+}
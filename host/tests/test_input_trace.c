@@ -0,0 +1,85 @@
+// Trace de entradas (inc/input_trace.c): registros sorteados gravados e lidos
+// de volta com os mesmos tipos, tempos e posições; buffer cheio parando de
+// gravar sem registro parcial; e o tipo 1 (a antiga leitura bruta do
+// joystick, fora do formato) recusado pelo leitor.
+
+#include "input_trace.h"
+#include "check.h"
+
+#define RECORDS 20000
+
+static uint8_t buf[RECORDS * 16];
+static trace_record_t expected[RECORDS];
+
+static void test_round_trip(void) {
+    input_trace_t trace;
+    input_trace_init(&trace, buf, sizeof(buf));
+    input_trace_start(&trace, 0xFFFFF000u);  // Tempos passando pela volta de 32 bits
+    uint32_t now = 0xFFFFF000u;
+    for (int i = 0; i < RECORDS; ++i) {
+        now += check_random() % 4 ? check_random() % 2000 : check_random();
+        trace_record_t *r = &expected[i];
+        r->type = TRACE_BUTTON_A + check_random() % (TRACE_TYPES - TRACE_BUTTON_A);
+        r->time_us = now - 0xFFFFF000u;
+        r->x = r->y = 0;
+        bool ok;
+        if (r->type == TRACE_TARGET || r->type == TRACE_CURSOR) {
+            r->x = check_random() & 0xFF;
+            r->y = check_random() & 0xFF;
+            ok = r->type == TRACE_TARGET ? input_trace_target(&trace, now, r->x, r->y)
+                                         : input_trace_cursor(&trace, now, r->x, r->y);
+        } else {
+            ok = input_trace_event(&trace, r->type, now);
+        }
+        CHECK(ok, "registro %d recusado", i);
+    }
+    CHECK(trace.records == RECORDS && !trace.full, "%u registros gravados", trace.records);
+
+    input_trace_reader_t reader;
+    input_trace_reader_init(&reader, buf, trace.len);
+    trace_record_t rec;
+    int n = 0;
+    while (input_trace_next(&reader, &rec) && n < RECORDS) {
+        const trace_record_t *e = &expected[n];
+        CHECK(rec.type == e->type && rec.time_us == e->time_us && rec.x == e->x && rec.y == e->y,
+              "registro %d: tipo %u em %u (%u, %u), esperado tipo %u em %u (%u, %u)", n, rec.type, rec.time_us,
+              rec.x, rec.y, e->type, e->time_us, e->x, e->y);
+        n++;
+    }
+    CHECK(n == RECORDS && reader.pos == trace.len, "%d registros lidos", n);
+}
+
+static void test_full(void) {
+    uint8_t small[64];
+    input_trace_t trace;
+    input_trace_init(&trace, small, sizeof(small));
+    int accepted = 0;
+    for (int i = 0; i < 100; ++i) accepted += input_trace_cursor(&trace, i * 1000, i, i);
+    CHECK(trace.full && accepted == (int)trace.records && accepted > 0, "buffer cheio: %d aceitos", accepted);
+    CHECK(!input_trace_event(&trace, TRACE_CLICK, 200000), "gravou depois de cheio");
+
+    // Tudo o que foi aceito é lido inteiro
+    input_trace_reader_t reader;
+    input_trace_reader_init(&reader, small, trace.len);
+    trace_record_t rec;
+    int n = 0;
+    while (input_trace_next(&reader, &rec)) CHECK(rec.type == TRACE_CURSOR && rec.x == n++, "registro %d", n);
+    CHECK(n == accepted, "%d lidos de %d", n, accepted);
+}
+
+static void test_unknown_types(void) {
+    static const uint8_t bad[][4] = {{1, 0, 0, 0}, {0, 0, 0, 0}, {TRACE_TYPES, 0, 0, 0}};
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i) {
+        input_trace_reader_t reader;
+        input_trace_reader_init(&reader, bad[i], sizeof(bad[i]));
+        trace_record_t rec;
+        CHECK(!input_trace_next(&reader, &rec), "tipo %u aceito", bad[i][0]);
+    }
+}
+
+int main(void) {
+    test_round_trip();
+    test_full();
+    test_unknown_types();
+    return check_result("input_trace");
+}
@@ -0,0 +1,217 @@
+// Joystick calibrado (inc/joystick.c): tabelas monotônicas para várias
+// configurações e calibrações, zona morta no pixel central, histerese na
+// fronteira entre pixels, recusa de calibrações curtas (varredura e extremos
+// gravados) e configurações fora da faixa (zona morta de 100%).
+
+#include "joystick.h"
+#include "check.h"
+#include <string.h>
+
+#define WIDTH 128
+#define HEIGHT 64
+#define LUT_STEP (1u << (JOYSTICK_ADC_BITS - JOYSTICK_LUT_BITS))
+
+static joystick_t js;
+
+// Tabela de cada eixo sem voltas: cresce (ou decresce, se invertido) e vai
+// de uma borda da tela à outra quando a calibração cobre o ADC inteiro
+static void check_luts(const char *what, bool full_range) {
+    for (int axis = 0; axis < 2; ++axis) {
+        const uint8_t *lut = js.lut[axis];
+        int last = js.size[axis] - 1;
+        for (uint32_t i = 1; i < JOYSTICK_LUT_SIZE; ++i) {
+            bool ok = js.invert[axis] ? lut[i] <= lut[i - 1] : lut[i] >= lut[i - 1];
+            CHECK(ok && lut[i] <= last, "%s: eixo %d não monotônico na entrada %u", what, axis, i);
+            if (!ok) return;
+        }
+        if (full_range) {
+            int lo = js.invert[axis] ? last : 0, hi = js.invert[axis] ? 0 : last;
+            CHECK(lut[0] == lo && lut[JOYSTICK_LUT_SIZE - 1] == hi, "%s: eixo %d vai de %u a %u", what, axis, lut[0],
+                  lut[JOYSTICK_LUT_SIZE - 1]);
+        }
+    }
+}
+
+static void test_monotonic(void) {
+    static const uint16_t dead_zones[] = {0, 123, 1000, 4095};
+    static const uint16_t curves[] = {0, 2048, 4096};
+    for (size_t d = 0; d < sizeof(dead_zones) / sizeof(dead_zones[0]); ++d) {
+        for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); ++c) {
+            joystick_config_t config = {dead_zones[d], curves[c], 3};
+            joystick_init(&js, &config, WIDTH, HEIGHT, c & 1);
+            check_luts("padrão", dead_zones[d] < 4095);
+
+            // Centro e extremos sorteados, sempre válidos
+            for (int k = 0; k < 200; ++k) {
+                joystick_axis_cal_t cal[2];
+                uint16_t center[2];
+                for (int axis = 0; axis < 2; ++axis) {
+                    center[axis] = JOYSTICK_MIN_SPAN + check_random() % (JOYSTICK_ADC_MAX - 2 * JOYSTICK_MIN_SPAN);
+                    cal[axis].min = check_random() % (center[axis] - JOYSTICK_MIN_SPAN + 1);
+                    cal[axis].max = center[axis] + JOYSTICK_MIN_SPAN +
+                                    check_random() % (JOYSTICK_ADC_MAX - center[axis] - JOYSTICK_MIN_SPAN + 1);
+                }
+                joystick_set_center(&js, center[0], center[1]);
+                CHECK(joystick_set_extents(&js, cal), "extremos válidos recusados");
+                check_luts("calibrado", false);
+            }
+        }
+    }
+}
+
+// Entradas cujo meio fica dentro da zona morta levam ao pixel central
+static void test_dead_zone(void) {
+    joystick_config_t config = {1000, 0, 3};
+    joystick_init(&js, &config, WIDTH, HEIGHT, false);
+    joystick_set_center(&js, 1800, 2300);
+    for (int axis = 0; axis < 2; ++axis) {
+        const joystick_axis_cal_t *cal = &js.cal[axis];
+        int center_px = js.size[axis] / 2, inside = 0;
+        for (uint32_t i = 0; i < JOYSTICK_LUT_SIZE; ++i) {
+            int32_t raw = i * LUT_STEP + LUT_STEP / 2;
+            int32_t span = raw >= cal->center ? cal->max - cal->center : cal->center - cal->min;
+            int32_t dist = raw >= cal->center ? raw - cal->center : cal->center - raw;
+            if ((int64_t)dist * JOYSTICK_ONE >= (int64_t)config.dead_zone * span) continue;
+            inside++;
+            CHECK(js.lut[axis][i] == center_px, "eixo %d: entrada %u na zona morta em %u", axis, i, js.lut[axis][i]);
+        }
+        CHECK(inside > 100, "eixo %d: só %d entradas na zona morta", axis, inside);
+        // E o curso continua indo de uma borda à outra
+        CHECK(js.lut[axis][0] == 0 && js.lut[axis][JOYSTICK_LUT_SIZE - 1] == js.size[axis] - 1,
+              "eixo %d sem curso completo", axis);
+    }
+}
+
+// Leitura oscilando entre duas entradas vizinhas de pixels diferentes não
+// move o cursor; passar uma entrada além da fronteira move
+static void test_hysteresis(void) {
+    joystick_config_t config = {0, 0, 0};  // Sem filtro: a leitura vai direto à tabela
+    joystick_init(&js, &config, WIDTH, HEIGHT, false);
+    const uint8_t *lut = js.lut[0];
+    uint32_t edge = 0;
+    // Longe do centro, onde o cursor começa
+    for (uint32_t i = 3 * JOYSTICK_LUT_SIZE / 4; i < JOYSTICK_LUT_SIZE - 2 && !edge; ++i) {
+        if (lut[i] != lut[i - 1]) edge = i;
+    }
+    CHECK(edge && lut[edge + 1] == lut[edge] && lut[edge - 2] == lut[edge - 1], "fronteira sem vizinhos iguais");
+
+    uint16_t below = edge * LUT_STEP - 1, above = edge * LUT_STEP;
+    uint16_t y = JOYSTICK_ADC_MAX / 2;
+    joystick_update(&js, below, y);
+    uint8_t start = js.x;
+    CHECK(start == lut[edge - 1], "posição inicial %u", start);
+    int moves = 0;
+    for (int k = 0; k < 1000; ++k)
+        moves += joystick_update(&js, k & 1 ? above : below, y);
+    CHECK(moves == 0 && js.x == start, "%d trocas de pixel oscilando na fronteira", moves);
+
+    CHECK(joystick_update(&js, (edge + 1) * LUT_STEP, y) && js.x == lut[edge], "não saiu do pixel além da histerese");
+    // E a volta também tem folga
+    CHECK(!joystick_update(&js, below, y) && js.x == lut[edge], "voltou sem passar da histerese");
+    CHECK(joystick_update(&js, (edge - 1) * LUT_STEP - 1, y) && js.x == start, "não voltou ao pixel de antes");
+}
+
+static bool cal_equal(const joystick_axis_cal_t *a, const joystick_axis_cal_t *b) {
+    return a[0].min == b[0].min && a[0].center == b[0].center && a[0].max == b[0].max && a[1].min == b[1].min &&
+           a[1].center == b[1].center && a[1].max == b[1].max;
+}
+
+// Varredura: cada lado de cada eixo precisa de JOYSTICK_MIN_SPAN contagens
+static void test_calibration(void) {
+    joystick_init(&js, &joystick_default_config, WIDTH, HEIGHT, true);
+    joystick_set_center(&js, 2000, 2100);
+    joystick_axis_cal_t before[2];
+    memcpy(before, js.cal, sizeof(before));
+
+    // Um lado do eixo Y curto por uma contagem
+    joystick_calibration_begin(&js);
+    CHECK(js.calibrating, "calibração não começou");
+    joystick_update(&js, 2000 - JOYSTICK_MIN_SPAN, 2100 - JOYSTICK_MIN_SPAN);
+    joystick_update(&js, 2000 + JOYSTICK_MIN_SPAN, 2100 + JOYSTICK_MIN_SPAN - 1);
+    CHECK(!joystick_calibration_end(&js) && !js.calibrating, "varredura curta aceita");
+    CHECK(cal_equal(js.cal, before), "varredura recusada mudou a calibração");
+
+    // Sem varredura nenhuma
+    joystick_calibration_begin(&js);
+    CHECK(!joystick_calibration_end(&js), "varredura vazia aceita");
+
+    // Completa: os extremos vistos viram a calibração
+    joystick_calibration_begin(&js);
+    joystick_update(&js, 300, 3900);
+    joystick_update(&js, 3800, 200);
+    joystick_update(&js, 2000, 2100);
+    CHECK(joystick_calibration_end(&js), "varredura completa recusada");
+    CHECK(js.cal[0].min == 300 && js.cal[0].max == 3800 && js.cal[1].min == 200 && js.cal[1].max == 3900 &&
+          js.cal[0].center == 2000 && js.cal[1].center == 2100,
+          "calibração x %u..%u..%u y %u..%u..%u", js.cal[0].min, js.cal[0].center, js.cal[0].max, js.cal[1].min,
+          js.cal[1].center, js.cal[1].max);
+    // Fora da calibração as leituras não mexem nos extremos
+    joystick_update(&js, 0, JOYSTICK_ADC_MAX);
+    CHECK(js.cal[0].min == 300 && js.cal[1].max == 3900, "leitura fora da calibração mudou os extremos");
+}
+
+// Extremos gravados: cada lado com pelo menos JOYSTICK_MIN_SPAN, centro dentro
+static void test_extents(void) {
+    joystick_init(&js, &joystick_default_config, WIDTH, HEIGHT, true);
+    joystick_set_center(&js, 2000, 2100);
+    const uint16_t c[2] = {2000, 2100};
+    joystick_axis_cal_t before[2];
+    memcpy(before, js.cal, sizeof(before));
+
+    for (int axis = 0; axis < 2; ++axis) {
+        const struct {
+            int32_t min, max;
+            bool ok;
+        } cases[] = {
+            {c[axis] - JOYSTICK_MIN_SPAN, c[axis] + JOYSTICK_MIN_SPAN, true},
+            {c[axis] - JOYSTICK_MIN_SPAN + 1, c[axis] + JOYSTICK_MIN_SPAN, false},
+            {c[axis] - JOYSTICK_MIN_SPAN, c[axis] + JOYSTICK_MIN_SPAN - 1, false},
+            {c[axis] + 1, c[axis] + JOYSTICK_MIN_SPAN, false},      // Mínimo acima do centro
+            {c[axis] - JOYSTICK_MIN_SPAN, c[axis] - 1, false},      // Máximo abaixo do centro
+            {0, JOYSTICK_ADC_MAX, true},
+        };
+        for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); ++k) {
+            joystick_axis_cal_t cal[2] = {{0, c[0], JOYSTICK_ADC_MAX}, {0, c[1], JOYSTICK_ADC_MAX}};
+            cal[axis].min = cases[k].min;
+            cal[axis].max = cases[k].max;
+            bool ok = joystick_set_extents(&js, cal);
+            CHECK(ok == cases[k].ok, "eixo %d, extremos %d..%d: %s", axis, cases[k].min, cases[k].max,
+                  ok ? "aceitos" : "recusados");
+            if (ok) {
+                CHECK(js.cal[axis].min == cal[axis].min && js.cal[axis].max == cal[axis].max &&
+                          js.cal[axis].center == c[axis],
+                      "extremos aceitos não aplicados");
+                memcpy(before, js.cal, sizeof(before));
+            } else {
+                CHECK(cal_equal(js.cal, before), "extremos recusados mudaram a calibração");
+            }
+        }
+    }
+}
+
+// Zona morta de 100% ou mais e curva acima de 1,0 são limitadas
+static void test_config_bounds(void) {
+    static const joystick_config_t configs[] = {
+        {JOYSTICK_ONE, 0, 3},
+        {0xFFFF, 0xFFFF, 3},
+        {JOYSTICK_ONE - 1, JOYSTICK_ONE, 3},
+    };
+    for (size_t k = 0; k < sizeof(configs) / sizeof(configs[0]); ++k) {
+        joystick_init(&js, &joystick_default_config, WIDTH, HEIGHT, false);
+        joystick_configure(&js, &configs[k]);
+        CHECK(js.config.dead_zone < JOYSTICK_ONE && js.config.curve <= JOYSTICK_ONE, "configuração %zu sem limite", k);
+        check_luts("limitada", false);
+        joystick_init(&js, &configs[k], WIDTH, HEIGHT, false);
+        CHECK(js.config.dead_zone < JOYSTICK_ONE && js.config.curve <= JOYSTICK_ONE, "init %zu sem limite", k);
+    }
+}
+
+int main(void) {
+    test_monotonic();
+    test_dead_zone();
+    test_hysteresis();
+    test_calibration();
+    test_extents();
+    test_config_bounds();
+    return check_result("joystick");
+}
@@ -0,0 +1,125 @@
+// As primitivas de desenho do SSD1306 por trechos de bytes (fill, hline,
+// vline, rect e draw_char) comparadas, bit a bit, com uma implementação de
+// referência pixel a pixel que recorta cada pixel fora da tela. As entradas
+// são sorteadas em toda a faixa de uint8_t, então boa parte cruza as bordas.
+
+#include "ssd1306.h"
+#include "font.h"
+#include "check.h"
+#include <string.h>
+
+#define ITERATIONS 200000
+#define FONT_OFFSET 37  // Minúsculas, como em ssd1306.c
+
+static ssd1306_t fast, ref;
+
+static void ref_pixel(int x, int y, bool value) {
+    if (x < 0 || y < 0 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    ssd1306_pixel(&ref, x, y, value);
+}
+
+static void ref_fill(bool value) {
+    for (int y = 0; y < SSD1306_HEIGHT; ++y)
+        for (int x = 0; x < SSD1306_WIDTH; ++x)
+            ref_pixel(x, y, value);
+}
+
+static void ref_hline(int x0, int x1, int y, bool value) {
+    for (int x = x0; x <= x1; ++x)
+        ref_pixel(x, y, value);
+}
+
+static void ref_vline(int x, int y0, int y1, bool value) {
+    for (int y = y0; y <= y1; ++y)
+        ref_pixel(x, y, value);
+}
+
+static void ref_rect(int top, int left, int width, int height, bool value, bool fill) {
+    if (width == 0 || height == 0) return;
+    int right = left + width - 1, bottom = top + height - 1;
+    if (fill) {
+        for (int x = left; x <= right; ++x)
+            ref_vline(x, top, bottom, value);
+        return;
+    }
+    ref_hline(left, right, top, value);
+    ref_hline(left, right, bottom, value);
+    ref_vline(left, top, bottom, value);
+    ref_vline(right, top, bottom, value);
+}
+
+static void ref_draw_char(char c, int x, int y) {
+    int index = 0;
+    if (c >= 'A' && c <= 'Z') index = (c - 'A' + 11) * 8;
+    else if (c >= 'a' && c <= 'z') index = (c - 'a' + FONT_OFFSET) * 8;
+    else if (c >= '0' && c <= '9') index = (c - '0' + 1) * 8;
+    for (int i = 0; i < 8; ++i)
+        for (int j = 0; j < 8; ++j)
+            ref_pixel(x + i, y + j, font[index + i] & (1 << j));
+}
+
+// Coordenada sorteada, concentrada perto das bordas da tela
+static uint8_t random_coord(int size) {
+    switch (check_random() % 4) {
+        case 0: return check_random() & 0xFF;
+        case 1: return size - 1 - check_random() % 8;
+        case 2: return check_random() % 8;
+        default: return check_random() % size;
+    }
+}
+
+static const char chars[] = "AZaz09Mx7 ?";
+
+int main(void) {
+    // Conteúdo inicial aleatório: limpar e acender têm de preservar o resto
+    for (int i = 0; i < SSD1306_FB_SIZE; ++i)
+        fast.ram_buffer[i] = ref.ram_buffer[i] = check_random();
+
+    for (long it = 0; it < ITERATIONS && !check_failures; ++it) {
+        bool value = check_random() & 1;
+        const char *op = "";
+        switch (check_random() % 16) {
+            case 0:
+                op = "fill";
+                ssd1306_fill(&fast, value);
+                ref_fill(value);
+                break;
+            case 1: case 2: case 3: {
+                uint8_t x0 = random_coord(SSD1306_WIDTH), x1 = random_coord(SSD1306_WIDTH);
+                uint8_t y = random_coord(SSD1306_HEIGHT);
+                op = "hline";
+                ssd1306_hline(&fast, x0, x1, y, value);
+                ref_hline(x0, x1, y, value);
+                break;
+            }
+            case 4: case 5: case 6: {
+                uint8_t x = random_coord(SSD1306_WIDTH);
+                uint8_t y0 = random_coord(SSD1306_HEIGHT), y1 = random_coord(SSD1306_HEIGHT);
+                op = "vline";
+                ssd1306_vline(&fast, x, y0, y1, value);
+                ref_vline(x, y0, y1, value);
+                break;
+            }
+            case 7: case 8: case 9: case 10: case 11: {
+                uint8_t top = random_coord(SSD1306_HEIGHT), left = random_coord(SSD1306_WIDTH);
+                uint8_t w = check_random() % 4 ? check_random() % 40 : check_random() & 0xFF;
+                uint8_t h = check_random() % 4 ? check_random() % 24 : check_random() & 0xFF;
+                bool fill = check_random() & 1;
+                op = fill ? "rect cheio" : "rect";
+                ssd1306_rect(&fast, top, left, w, h, value, fill);
+                ref_rect(top, left, w, h, value, fill);
+                break;
+            }
+            default: {
+                char c = chars[check_random() % (sizeof(chars) - 1)];
+                uint8_t x = random_coord(SSD1306_WIDTH), y = random_coord(SSD1306_HEIGHT);
+                op = "draw_char";
+                ssd1306_draw_char(&fast, c, x, y);
+                ref_draw_char(c, x, y);
+                break;
+            }
+        }
+        CHECK(!memcmp(fast.ram_buffer, ref.ram_buffer, SSD1306_FB_SIZE), "%s diverge na iteração %ld", op, it);
+    }
+    return check_result("ssd1306_spans");
+}
@@ -0,0 +1,113 @@
+// Roda de temporizadores (inc/timer_wheel.c) contra um modelo de referência,
+// em passos aleatórios: armar, rearmar, cancelar e avançar de 1 tick a mais
+// de uma volta da roda. Os callbacks, por sua vez, cancelam ou rearmam
+// outros temporizadores (às vezes do mesmo tick) e a si mesmos. Cada disparo
+// tem de ser de um temporizador armado no modelo com prazo no tick atual, e
+// depois de avançar nenhum prazo vencido pode sobrar armado.
+
+#include "timer_wheel.h"
+#include "check.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STEPS 2000000
+#define TIMERS 48
+
+typedef struct {
+  bool armed;
+  uint32_t expires, period;
+} model_t;
+
+static timer_wheel_t wheel;
+static timer_wheel_timer_t timers[TIMERS];
+static model_t model[TIMERS];
+
+static void model_start(int id, uint32_t delay, uint32_t period) {
+    model[id].armed = true;
+    model[id].expires = wheel.now + (delay ? delay : 1);
+    model[id].period = period;
+}
+
+static bool callback(timer_wheel_timer_t *timer, void *user_data);
+
+static void start(int id, uint32_t delay, uint32_t period) {
+    timer_wheel_start(&wheel, &timers[id], delay, period, callback, (void *)(intptr_t)id);
+    model_start(id, delay, period);
+}
+
+static void cancel(int id) {
+    timer_wheel_cancel(&wheel, &timers[id]);
+    model[id].armed = false;
+}
+
+static uint32_t random_delay(void) {
+    switch (check_random() % 4) {
+        case 0: return check_random() % 4;                            // Tick seguinte ou logo depois
+        case 1: return TIMER_WHEEL_SLOTS * (1 + check_random() % 3);  // Mesmo slot, voltas depois
+        default: return check_random() % (3 * TIMER_WHEEL_SLOTS);
+    }
+}
+
+static bool callback(timer_wheel_timer_t *timer, void *user_data) {
+    int id = (int)(intptr_t)user_data;
+    CHECK(timer == &timers[id], "callback com o temporizador errado");
+    CHECK(model[id].armed && model[id].expires == wheel.now, "disparo do %d no tick %u (armado %d, prazo %u)", id,
+          wheel.now, model[id].armed, model[id].expires);
+    model[id].armed = false;
+
+    // Mexe em outros temporizadores, de preferência nos que vencem agora
+    for (int k = check_random() % 3; k > 0; --k) {
+        int other = check_random() % TIMERS;
+        for (int i = 0; i < TIMERS; ++i) {
+            if (model[i].armed && model[i].expires == wheel.now && check_random() % 2) other = i;
+        }
+        if (check_random() % 2) cancel(other);
+        else start(other, random_delay(), check_random() % 3 ? 0 : 1 + check_random() % 300);
+    }
+
+    bool keep = check_random() % 4 != 0;
+    if (check_random() % 8 == 0) {
+        // Rearma a si mesmo: o período de antes não vale mais
+        start(id, random_delay(), check_random() % 2 ? 0 : 1 + check_random() % 300);
+    } else if (keep && model[id].period && !model[id].armed) {
+        model_start(id, model[id].period, model[id].period);
+    }
+    return keep;
+}
+
+int main(void) {
+    timer_wheel_init(&wheel, 0xFFFFF000u);  // Perto da volta do contador de 32 bits
+    uint32_t fired_ticks = 0;
+    for (long step = 0; step < STEPS && !check_failures; ++step) {
+        int id = check_random() % TIMERS;
+        switch (check_random() % 8) {
+            case 0: case 1: case 2:
+                start(id, random_delay(), check_random() % 2 ? 0 : 1 + check_random() % 300);
+                break;
+            case 3:
+                cancel(id);
+                break;
+            default: {
+                uint32_t delta = check_random() % 64 ? 1 + check_random() % 4 : check_random() % (2 * TIMER_WHEEL_SLOTS);
+                uint32_t before = wheel.fired;
+                timer_wheel_advance(&wheel, wheel.now + delta);
+                fired_ticks += wheel.fired != before;
+                break;
+            }
+        }
+
+        int armed = 0;
+        for (int i = 0; i < TIMERS; ++i) {
+            CHECK(timer_wheel_armed(&timers[i]) == model[i].armed, "passo %ld: temporizador %d armado %d, modelo %d",
+                  step, i, timer_wheel_armed(&timers[i]), model[i].armed);
+            if (!model[i].armed) continue;
+            armed++;
+            CHECK((int32_t)(model[i].expires - wheel.now) > 0, "passo %ld: %d vencido no tick %u sem disparar", step,
+                  i, model[i].expires);
+            CHECK(timers[i].expires == model[i].expires, "passo %ld: prazo do %d", step, i);
+        }
+        CHECK(wheel.active == armed, "passo %ld: %u ativos, modelo %d", step, wheel.active, armed);
+    }
+    CHECK(fired_ticks > STEPS / 10, "só %u avanços com disparo", fired_ticks);
+    return check_result("timer_wheel");
+}
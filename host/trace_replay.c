@@ -0,0 +1,372 @@
+// Replay determinístico de um trace de entradas gravado na placa.
+//
+// Uso: trace_replay [--frames] [--bus-hz N] [--mirror SAIDA] arquivo
+//      trace_replay --synth SEGUNDOS [--seed N] > arquivo
+//
+// O arquivo é o despejo hexadecimal do comando 'd' no terminal USB (linhas
+// antes do cabeçalho JTR1 são ignoradas) ou o mesmo conteúdo em binário,
+// precedido por "JTR1". Os registros passam pela mesma máquina de estados do
+// firmware; os quadros seguem o escalonador, com o flush modelado pelo tempo
+// do barramento I2C. Ao fim imprime um resumo nome,valor (CSV); com --frames
+// imprime também uma linha por quadro (tempo, ns de desenho, bytes no
+// barramento). O estado final do jogo permite conferir que o replay foi fiel.
+// Os efeitos da tela final (screen_fx) seguem o mesmo relógio e os bytes de
+// comando deles aparecem em fx_bytes.
+// --mirror grava o espelhamento (fb_mirror) de cada quadro enviado, no mesmo
+// formato que a placa manda pela USB, para o mirror_decode.
+//
+// --synth gera uma sessão sintética (cursor indo até o alvo com ruído, cliques
+// e erros) no mesmo formato, útil sem uma placa à mão.
+
+#include "game.h"
+#include "game_render.h"
+#include "joystick.h"
+#include "input_trace.h"
+#include "fb_mirror.h"
+#include "screen_fx.h"
+#include "render_sched.h"
+#include "ssd1306.h"
+#include "hal_host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_MAX_BYTES (1 << 24)
+
+static ssd1306_t ssd;
+static game_t game;
+static render_sched_t sched;
+static game_snapshot_t frame_snap, last_snap;
+static game_view_t view;
+static screen_fx_t fx;
+
+static bool print_frames = false;
+static uint32_t bus_ns_per_byte = 90000;  // 9 bits por byte a 100 kHz
+static uint32_t flush_end_us = 0;
+
+static fb_mirror_t mirror;
+static FILE *mirror_out = NULL;
+
+static double total_render_ns = 0;
+static double max_render_ns = 0;
+static uint64_t total_bus_bytes = 0;
+static uint64_t fx_bytes = 0;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int hex_value(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Lê o trace em binário ou no despejo hexadecimal do terminal. Arquivos
+// maiores que TRACE_MAX_BYTES são recusados.
+static uint8_t *load_trace(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return NULL;
+    }
+    // Um byte a mais para detectar arquivo grande demais e para o '\0'
+    uint8_t *raw = malloc(TRACE_MAX_BYTES + 1);
+    if (!raw) {
+        fprintf(stderr, "%s: sem memória\n", path);
+        fclose(f);
+        return NULL;
+    }
+    size_t n = fread(raw, 1, TRACE_MAX_BYTES + 1, f);
+    fclose(f);
+    if (n > TRACE_MAX_BYTES) {
+        fprintf(stderr, "%s: maior que %d bytes\n", path, TRACE_MAX_BYTES);
+        free(raw);
+        return NULL;
+    }
+
+    // O binário tem n - 4 bytes e o hexadecimal no máximo n / 2
+    uint8_t *out = malloc(n ? n : 1);
+    if (!out) {
+        fprintf(stderr, "%s: sem memória\n", path);
+        free(raw);
+        return NULL;
+    }
+    *len = 0;
+    raw[n] = '\0';
+    if (n >= 4 && !memcmp(raw, INPUT_TRACE_MAGIC, 4) && raw[4] != ' ') {
+        *len = n - 4;
+        memcpy(out, raw + 4, *len);
+        free(raw);
+        return out;
+    }
+
+    char *p = strstr((char *)raw, INPUT_TRACE_MAGIC " ");
+    if (!p) {
+        fprintf(stderr, "%s: cabeçalho %s não encontrado\n", path, INPUT_TRACE_MAGIC);
+        free(raw);
+        free(out);
+        return NULL;
+    }
+    p = strchr(p, '\n');
+    while (p && *p) {
+        while (*p == '\n' || *p == '\r') p++;
+        if (!strncmp(p, "END", 3)) break;
+        int hi, lo;
+        while ((hi = hex_value(p[0])) >= 0 && (lo = hex_value(p[1])) >= 0) {
+            out[(*len)++] = (uint8_t)(hi << 4 | lo);
+            p += 2;
+        }
+        p = strchr(p, '\n');
+    }
+    free(raw);
+    return out;
+}
+
+static bool mirror_write(const uint8_t *data, size_t len, void *user_data) {
+    fwrite(data, 1, len, user_data);
+    return true;
+}
+
+// Mesmo critério do firmware: mudança visível com o jogo em andamento ou na
+// tela final agenda um quadro
+static void apply_snapshot(void) {
+    game_snapshot_t snap;
+    game_snapshot(&game, &snap);
+    frame_snap = snap;
+    if ((snap.game_over || (snap.playing && !snap.paused)) && !game_snapshot_equal(&snap, &last_snap))
+        render_sched_mark_dirty(&sched);
+    last_snap = snap;
+}
+
+// Desenha os quadros que o escalonador liberaria antes do instante limit
+static void run_frames_until(uint32_t limit, bool drain) {
+    while (sched.pending) {
+        uint32_t start = sched.last_frame_us + render_sched_interval(&sched);
+        if ((int32_t)(flush_end_us - start) > 0) start = flush_end_us;
+        if (!drain && (int32_t)(start - limit) >= 0) return;
+
+        double t0 = now_ns();
+        game_view_render(&view, &ssd, &frame_snap);
+        double render_ns = now_ns() - t0;
+
+        render_sched_begin(&sched, start);
+        ssd1306_send_data_async(&ssd);
+        uint32_t bytes = ssd1306_flush_bytes(&ssd);
+        render_sched_sent(&sched, start, bytes);
+        flush_end_us = start + (uint32_t)((uint64_t)bytes * bus_ns_per_byte / 1000);
+        render_sched_flush_done(&sched, flush_end_us);
+
+        if (mirror_out && bytes > 0) {
+            fb_mirror_begin(&mirror, ssd.front_buffer);
+            while (fb_mirror_step(&mirror))
+                ;
+        }
+
+        total_render_ns += render_ns;
+        if (render_ns > max_render_ns) max_render_ns = render_ns;
+        total_bus_bytes += bytes;
+        if (print_frames)
+            printf("frame,%lu,%.0f,%lu\n", (unsigned long)start, render_ns, (unsigned long)bytes);
+    }
+}
+
+// Efeitos da tela final até o instante limit, como o update_screen_fx: o
+// efeito começa quando a tela final termina de chegar ao display
+static void run_fx_until(uint32_t limit) {
+    size_t before = hal_host_i2c_bytes();
+    if (!frame_snap.game_over) {
+        if (screen_fx_active(&fx))
+            screen_fx_stop(&fx, &ssd);
+    } else if (!sched.pending && (int32_t)(limit - flush_end_us) >= 0) {
+        if (!screen_fx_active(&fx))
+            screen_fx_start(&fx, &ssd, frame_snap.victory ? SCREEN_FX_VICTORY : SCREEN_FX_GAME_OVER, flush_end_us);
+        uint32_t deadline;
+        while (screen_fx_next(&fx, &deadline) && (int32_t)(limit - deadline) >= 0)
+            screen_fx_poll(&fx, &ssd, deadline);
+    }
+    fx_bytes += hal_host_i2c_bytes() - before;
+}
+
+// Aplica um registro como o loop principal do firmware faria
+static void apply_record(const trace_record_t *rec) {
+    switch (rec->type) {
+        case TRACE_BUTTON_A:
+            game_toggle_pause(&game);
+            break;
+        case TRACE_BUTTON_B:
+        case TRACE_RESET:
+            game_reset(&game);
+            break;
+        case TRACE_CLICK:
+        case TRACE_CLAP:
+            game_click(&game);
+            break;
+        case TRACE_TARGET:
+            game_set_target(&game, rec->x, rec->y);
+            break;
+        case TRACE_CURSOR:
+            game_set_cursor(&game, rec->x, rec->y);
+            break;
+    }
+}
+
+static int replay(const uint8_t *buf, size_t len) {
+    hal_host_reset();
+    ssd1306_init(&ssd, false, 0x3C, NULL);
+    game_view_init(&view);
+    screen_fx_init(&fx);
+    game_init(&game);
+    render_sched_init(&sched, RENDER_SCHED_MIN_INTERVAL_US, 0);
+    memset(&last_snap, 0, sizeof(last_snap));
+    apply_snapshot();
+
+    input_trace_reader_t reader;
+    trace_record_t rec;
+    uint32_t records = 0;
+    uint32_t end_us = 0;
+    input_trace_reader_init(&reader, buf, len);
+    while (input_trace_next(&reader, &rec)) {
+        run_frames_until(rec.time_us, false);
+        run_fx_until(rec.time_us);
+        apply_record(&rec);
+        apply_snapshot();
+        run_fx_until(rec.time_us);
+        end_us = rec.time_us;
+        records++;
+    }
+    run_frames_until(0, true);
+    run_fx_until(end_us);
+
+    if (reader.pos != len)
+        fprintf(stderr, "aviso: trace truncado no byte %lu de %lu\n", (unsigned long)reader.pos, (unsigned long)len);
+
+    uint32_t frames = sched.frames;
+    printf("records,%lu\n", (unsigned long)records);
+    printf("trace_bytes,%lu\n", (unsigned long)len);
+    printf("duration_ms,%.1f\n", end_us / 1000.0);
+    printf("frames,%lu\n", (unsigned long)frames);
+    printf("frames_skipped,%lu\n", (unsigned long)sched.skipped);
+    printf("fps,%.1f\n", end_us ? frames * 1e6 / end_us : 0.0);
+    printf("bus_bytes,%llu\n", (unsigned long long)total_bus_bytes);
+    printf("bytes_per_frame,%.1f\n", frames ? (double)total_bus_bytes / frames : 0.0);
+    printf("fx_bytes,%llu\n", (unsigned long long)fx_bytes);
+    printf("render_ns_mean,%.0f\n", frames + sched.skipped ? total_render_ns / (frames + sched.skipped) : 0.0);
+    printf("render_ns_max,%.0f\n", max_render_ns);
+    if (mirror_out)
+        printf("mirror_bytes,%lu\n", (unsigned long)mirror.bytes_out);
+    printf("final_score,%u\n", game.score);
+    printf("final_hits,%lu\n", (unsigned long)game.hit_count);
+    printf("final_resets,%lu\n", (unsigned long)game.reset_count);
+    return 0;
+}
+
+// Sessão sintética: o cursor persegue o alvo com ruído na leitura do ADC e
+// clica ao chegar perto; às vezes erra, pausa ou reinicia
+static int synth(uint32_t seconds, unsigned seed) {
+    static uint8_t buf[TRACE_MAX_BYTES / 16];
+    input_trace_t trace;
+    input_trace_init(&trace, buf, sizeof(buf));
+    srand(seed);
+    game_init(&game);
+    static joystick_t js;
+    joystick_init(&js, &joystick_default_config, GAME_WIDTH, GAME_HEIGHT, true);
+
+    int32_t ax = 2048, ay = 2048;  // Posição do joystick em contagens do ADC
+    uint32_t game_over_at = 0;
+    for (uint32_t t = 1000; t < seconds * 1000000u && !trace.full; t += 1000) {
+        uint32_t hits = game.hit_count, resets = game.reset_count;
+
+        if (game.game_over) {
+            if (t - game_over_at >= GAME_RESET_DELAY_MS * 1000u) {
+                input_trace_event(&trace, TRACE_RESET, t);
+                game_reset(&game);
+            }
+        } else if (rand() % 20000 == 0) {
+            input_trace_event(&trace, TRACE_BUTTON_A, t);
+            game_toggle_pause(&game);
+        } else if (game_accepts_input(&game)) {
+            int32_t gx = game.target_x * 4096 / GAME_WIDTH + 16;
+            int32_t gy = 4095 - (game.target_y * 4096 / GAME_HEIGHT + 32);
+            ax += (gx - ax) / 24 + rand() % 9 - 4;
+            ay += (gy - ay) / 24 + rand() % 9 - 4;
+            if (ax < 0) ax = 0;
+            if (ax > 4095) ax = 4095;
+            if (ay < 0) ay = 0;
+            if (ay > 4095) ay = 4095;
+
+            // Mesmo caminho do firmware: joystick filtrado e calibrado
+            joystick_update(&js, ax, ay);
+            if (js.x != game.cursor_x || js.y != game.cursor_y) {
+                game_set_cursor(&game, js.x, js.y);
+                input_trace_cursor(&trace, t, js.x, js.y);
+            }
+
+            bool near = abs(game.cursor_x - game.target_x) < GAME_HIT_RADIUS &&
+                        abs(game.cursor_y - game.target_y) < GAME_HIT_RADIUS;
+            if ((near && rand() % 50 == 0) || rand() % 3000 == 0) {
+                input_trace_event(&trace, rand() % 4 ? TRACE_CLICK : TRACE_CLAP, t);
+                if (game_click(&game)) game_over_at = t;
+            }
+        } else if (game.paused && rand() % 2000 == 0) {
+            input_trace_event(&trace, TRACE_BUTTON_A, t);
+            game_toggle_pause(&game);
+        }
+
+        if (game.hit_count != hits || game.reset_count != resets)
+            input_trace_target(&trace, t, game.target_x, game.target_y);
+    }
+
+    input_trace_dump_hex(&trace);
+    fprintf(stderr, "final_score,%u\nfinal_hits,%lu\nfinal_resets,%lu\n", game.score,
+            (unsigned long)game.hit_count, (unsigned long)game.reset_count);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    const char *mirror_path = NULL;
+    long synth_seconds = 0;
+    unsigned seed = 1;
+    bool usage = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--frames")) print_frames = true;
+        else if (!strcmp(argv[i], "--bus-hz") && i + 1 < argc) bus_ns_per_byte = 9000000000ull / atol(argv[++i]);
+        else if (!strcmp(argv[i], "--mirror") && i + 1 < argc) mirror_path = argv[++i];
+        else if (!strcmp(argv[i], "--synth") && i + 1 < argc) synth_seconds = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = atoi(argv[++i]);
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+        else usage = true;
+    }
+
+    if (!usage && synth_seconds > 0)
+        return synth(synth_seconds, seed);
+
+    if (usage || !path) {
+        fprintf(stderr, "uso: %s [--frames] [--bus-hz N] [--mirror SAIDA] arquivo\n", argv[0]);
+        fprintf(stderr, "     %s --synth SEGUNDOS [--seed N] > arquivo\n", argv[0]);
+        return 2;
+    }
+
+    if (mirror_path) {
+        mirror_out = fopen(mirror_path, "wb");
+        if (!mirror_out) {
+            perror(mirror_path);
+            return 1;
+        }
+        fb_mirror_init(&mirror, mirror_write, mirror_out);
+    }
+
+    size_t len;
+    uint8_t *buf = load_trace(path, &len);
+    if (!buf) return 1;
+    int status = replay(buf, len);
+    free(buf);
+    if (mirror_out) fclose(mirror_out);
+    return status;
+}
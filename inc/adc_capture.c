@@ -0,0 +1,104 @@
+#include "adc_capture.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Múltiplo de 3: ao fim da transferência a próxima amostra volta à entrada 0
+#define CAPTURE_COUNT 0xFFFFFFFFu
+
+static uint16_t ring[ADC_CAPTURE_RING_SAMPLES] __attribute__((aligned(1u << ADC_CAPTURE_RING_BITS)));
+static int dma_chan = -1;
+
+// Recomeça a captura do início do buffer, com o round robin na entrada 0
+static void adc_capture_start(void) {
+    adc_run(false);
+    adc_fifo_drain();
+    adc_select_input(0);
+    dma_channel_set_write_addr(dma_chan, ring, false);
+    dma_channel_set_trans_count(dma_chan, CAPTURE_COUNT, true);
+    adc_run(true);
+}
+
+// A contagem do DMA só se esgota após ~2^32 amostras (horas de uso)
+static void adc_capture_irq_handler(void) {
+    if (dma_chan < 0 || !dma_channel_get_irq1_status(dma_chan)) return;
+    dma_channel_acknowledge_irq1(dma_chan);
+    adc_capture_start();
+}
+
+// sample_rate_hz é a taxa total, dividida entre as três entradas
+void adc_capture_init(uint32_t sample_rate_hz) {
+    adc_set_round_robin((1u << ADC_CAPTURE_CHANNELS) - 1);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(48000000.0f / sample_rate_hz - 1.0f);
+
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, ADC_CAPTURE_RING_BITS);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(dma_chan, &c, ring, &adc_hw->fifo, CAPTURE_COUNT, false);
+
+    dma_channel_set_irq1_enabled(dma_chan, true);
+    irq_add_shared_handler(DMA_IRQ_1, adc_capture_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adc_capture_start();
+}
+
+// Índice absoluto da amostra mais recente do canal; false se ainda não houver
+static inline bool adc_capture_last_index(uint channel, uint32_t *index) {
+    uint32_t count = CAPTURE_COUNT - dma_channel_hw_addr(dma_chan)->transfer_count;
+    if (count <= channel) return false;
+    uint32_t last = count - 1;
+    *index = last - (last + ADC_CAPTURE_CHANNELS - channel) % ADC_CAPTURE_CHANNELS;
+    return true;
+}
+
+// Última amostra bruta de 12 bits do canal
+uint16_t adc_capture_latest(uint channel) {
+    uint32_t i;
+    if (!adc_capture_last_index(channel, &i)) return 0;
+    return ring[i & (ADC_CAPTURE_RING_SAMPLES - 1)];
+}
+
+// Média das últimas ADC_CAPTURE_OVERSAMPLE amostras do canal (sobreamostragem
+// e decimação), ainda na escala de 12 bits
+uint16_t adc_capture_read(uint channel) {
+    uint32_t i;
+    if (!adc_capture_last_index(channel, &i)) return 0;
+
+    uint32_t sum = 0;
+    uint32_t n = 0;
+    while (n < ADC_CAPTURE_OVERSAMPLE) {
+        sum += ring[i & (ADC_CAPTURE_RING_SAMPLES - 1)];
+        n++;
+        if (i < ADC_CAPTURE_CHANNELS) break;
+        i -= ADC_CAPTURE_CHANNELS;
+    }
+    return sum / n;
+}
+
+// Copia para dst as amostras do canal a partir do índice absoluto *cursor e
+// avança o cursor. Se o consumidor ficou mais atrasado que o buffer (ou a
+// captura recomeçou), continua da amostra mais antiga ainda válida.
+uint32_t adc_capture_fetch(uint channel, uint32_t *cursor, uint16_t *dst, uint32_t max) {
+    uint32_t last;
+    if (!adc_capture_last_index(channel, &last)) return 0;
+
+    const uint32_t span = (ADC_CAPTURE_RING_SAMPLES / ADC_CAPTURE_CHANNELS - 1) * ADC_CAPTURE_CHANNELS;
+    uint32_t oldest = last >= span ? last - span : channel;
+    if (*cursor < oldest || *cursor > last + ADC_CAPTURE_CHANNELS)
+        *cursor = oldest;
+
+    uint32_t i = *cursor + (channel + ADC_CAPTURE_CHANNELS - *cursor % ADC_CAPTURE_CHANNELS) % ADC_CAPTURE_CHANNELS;
+    uint32_t n = 0;
+    while (i <= last && n < max) {
+        dst[n++] = ring[i & (ADC_CAPTURE_RING_SAMPLES - 1)];
+        i += ADC_CAPTURE_CHANNELS;
+    }
+    *cursor = i;
+    return n;
+}
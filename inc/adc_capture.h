@@ -0,0 +1,20 @@
+#ifndef ADC_CAPTURE_H
+#define ADC_CAPTURE_H
+
+#include "pico/stdlib.h"
+
+// Captura contínua do ADC em round robin nas entradas 0 (joystick Y),
+// 1 (joystick X) e 2 (microfone). O DMA grava as amostras num buffer
+// circular; as leituras abaixo só consultam a memória, sem esperar conversão.
+
+#define ADC_CAPTURE_CHANNELS 3
+#define ADC_CAPTURE_RING_BITS 12  // Buffer de 2^12 bytes = 2048 amostras
+#define ADC_CAPTURE_RING_SAMPLES (1u << (ADC_CAPTURE_RING_BITS - 1))
+#define ADC_CAPTURE_OVERSAMPLE 16  // Amostras médias por leitura filtrada
+
+void adc_capture_init(uint32_t sample_rate_hz);
+uint16_t adc_capture_latest(uint channel);
+uint16_t adc_capture_read(uint channel);
+uint32_t adc_capture_fetch(uint channel, uint32_t *cursor, uint16_t *dst, uint32_t max);
+
+#endif
@@ -0,0 +1,114 @@
+#include "audio.h"
+#include "hal.h"
+#include "hardware/clocks.h"
+#include "pico/critical_section.h"
+
+typedef struct {
+  uint gpio;
+  const audio_note_t *notes;  // NULL = voz parada
+  uint count, index;
+  uint32_t remaining_ms;
+  audio_note_t tone;          // Nota avulsa de audio_play_tone
+} audio_voice_t;
+
+static audio_voice_t voices[AUDIO_VOICES];
+static critical_section_t lock;  // Vozes são usadas pelo core1 e pelo timer no core0
+static struct repeating_timer timer;  // Sempre ativo, criado em audio_init
+
+// Configura o PWM para a frequência pedida. O divisor (em 1/16) é o menor que
+// mantém o wrap em 16 bits, o que preserva a maior resolução de período.
+static void audio_set_pwm(audio_voice_t *v, uint16_t freq_hz, uint8_t volume) {
+    if (freq_hz == 0 || volume == 0) {
+        hal_pwm_set_level(v->gpio, 0);
+        return;
+    }
+
+    uint32_t clock = clock_get_hz(clk_sys);
+    uint32_t div16 = (uint32_t)(((uint64_t)clock * 16 + (uint64_t)freq_hz * 65536 - 1) / ((uint64_t)freq_hz * 65536));
+    if (div16 < 16) div16 = 16;
+    if (div16 > 0xFFF) div16 = 0xFFF;
+
+    uint32_t period = (uint32_t)(((uint64_t)clock * 16) / ((uint64_t)div16 * freq_hz));
+    if (period > 65536) period = 65536;
+    if (period < 2) period = 2;
+
+    hal_pwm_configure(v->gpio, div16, period - 1);
+    hal_pwm_set_level(v->gpio, (period * volume) / 512);
+}
+
+// Inicia a nota atual da voz ou a encerra ao fim da sequência
+static void audio_start_note(audio_voice_t *v) {
+    if (v->index >= v->count) {
+        v->notes = NULL;
+        hal_pwm_set_level(v->gpio, 0);
+        hal_pwm_set_enabled(v->gpio, false);
+        return;
+    }
+    const audio_note_t *n = &v->notes[v->index];
+    audio_set_pwm(v, n->freq_hz, n->volume);
+    v->remaining_ms = n->duration_ms;
+    hal_pwm_set_enabled(v->gpio, true);
+}
+
+// Nunca devolve false: desmontar o timer aqui correria com audio_play o
+// rearmando no outro core, e o SDK ainda escreve na estrutura depois do
+// callback. Sem vozes tocando, o tick só confere as duas e sai.
+static bool audio_tick(struct repeating_timer *t) {
+    critical_section_enter_blocking(&lock);
+    for (uint i = 0; i < AUDIO_VOICES; ++i) {
+        audio_voice_t *v = &voices[i];
+        if (!v->notes) continue;
+        if (v->remaining_ms > AUDIO_TICK_MS) {
+            v->remaining_ms -= AUDIO_TICK_MS;
+        } else {
+            v->index++;
+            audio_start_note(v);
+        }
+    }
+    critical_section_exit(&lock);
+    return true;
+}
+
+void audio_init(uint gpio_voice0, uint gpio_voice1) {
+    critical_section_init(&lock);
+    uint gpios[AUDIO_VOICES] = {gpio_voice0, gpio_voice1};
+    for (uint i = 0; i < AUDIO_VOICES; ++i) {
+        gpio_set_function(gpios[i], GPIO_FUNC_PWM);
+        voices[i].gpio = gpios[i];
+        voices[i].notes = NULL;
+        hal_pwm_set_level(gpios[i], 0);
+    }
+    // Período negativo: intervalo medido entre inícios de callback
+    add_repeating_timer_ms(-AUDIO_TICK_MS, audio_tick, NULL, &timer);
+}
+
+// Toca uma sequência; notes deve continuar válido até o fim da reprodução
+void audio_play(uint voice, const audio_note_t *notes, uint count) {
+    if (voice >= AUDIO_VOICES) return;
+
+    critical_section_enter_blocking(&lock);
+    audio_voice_t *v = &voices[voice];
+    v->notes = notes;
+    v->count = count;
+    v->index = 0;
+    audio_start_note(v);
+    critical_section_exit(&lock);
+}
+
+void audio_play_tone(uint voice, uint16_t freq_hz, uint16_t duration_ms, uint8_t volume) {
+    if (voice >= AUDIO_VOICES) return;
+    voices[voice].tone = (audio_note_t){freq_hz, duration_ms, volume};
+    audio_play(voice, &voices[voice].tone, 1);
+}
+
+void audio_stop(uint voice) {
+    if (voice >= AUDIO_VOICES) return;
+    critical_section_enter_blocking(&lock);
+    voices[voice].index = voices[voice].count;
+    if (voices[voice].notes) audio_start_note(&voices[voice]);
+    critical_section_exit(&lock);
+}
+
+bool audio_busy(uint voice) {
+    return voice < AUDIO_VOICES && voices[voice].notes != NULL;
+}
@@ -0,0 +1,26 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "pico/stdlib.h"
+
+// Motor de áudio para os dois buzzers. Cada voz toca uma sequência de notas;
+// um único timer repetitivo, criado em audio_init no core que atende o
+// alarme, avança todas as vozes a cada AUDIO_TICK_MS.
+
+#define AUDIO_VOICES 2
+#define AUDIO_TICK_MS 5          // Resolução das durações
+#define AUDIO_VOLUME_MAX 255     // Ciclo de trabalho de 50%
+
+typedef struct {
+  uint16_t freq_hz;      // 0 = pausa
+  uint16_t duration_ms;
+  uint8_t volume;        // 0..AUDIO_VOLUME_MAX
+} audio_note_t;
+
+void audio_init(uint gpio_voice0, uint gpio_voice1);
+void audio_play(uint voice, const audio_note_t *notes, uint count);
+void audio_play_tone(uint voice, uint16_t freq_hz, uint16_t duration_ms, uint8_t volume);
+void audio_stop(uint voice);
+bool audio_busy(uint voice);
+
+#endif
@@ -0,0 +1,72 @@
+#include "buttons.h"
+#include "button_debounce.pio.h"
+#include "hardware/irq.h"
+
+_Static_assert(BUTTONS_SAMPLE_HZ == 1000000u, "a conversão do carimbo supõe uma amostra por µs");
+
+static PIO btn_pio;
+static uint btn_count = 0;
+static uint btn_sm[BUTTONS_MAX];
+static buttons_callback_t btn_callback;
+static uint32_t start_us;    // time_us_32 quando as máquinas partiram
+static uint32_t stable_us;   // Amostras estáveis para trocar de estado
+static uint32_t events = 0;
+
+// Uma palavra por troca de estado: X (amostras, contando para baixo a partir
+// de 0xFFFFFFFF) nos bits 31..1 e o nível no bit 0
+static void buttons_irq_handler(void) {
+    uint32_t now = time_us_32();
+    for (uint i = 0; i < btn_count; ++i) {
+        while (!pio_sm_is_rx_fifo_empty(btn_pio, btn_sm[i])) {
+            uint32_t word = pio_sm_get(btn_pio, btn_sm[i]);
+            // Só 31 bits do relógio chegam: reconstrói o instante mais
+            // recente com esses bits que não está no futuro
+            uint32_t confirm_us = start_us + (0x7FFFFFFFu - (word >> 1));
+            confirm_us = now - ((now - confirm_us) & 0x7FFFFFFFu);
+
+            button_event_t event = {
+                .index = i,
+                .pressed = !(word & 1),
+                .edge_us = confirm_us - stable_us,
+            };
+            events++;
+            if (btn_callback) btn_callback(&event);
+        }
+    }
+}
+
+// debounce_us é o tempo que o nível precisa ficar estável para valer
+void buttons_init(PIO pio, const uint *pins, uint count, uint32_t debounce_us, buttons_callback_t callback) {
+    if (count > BUTTONS_MAX) count = BUTTONS_MAX;
+    if (debounce_us == 0) debounce_us = 1;
+    btn_pio = pio;
+    btn_count = count;
+    btn_callback = callback;
+    stable_us = debounce_us;  // N + 1 amostras de 1 µs
+
+    uint offset = pio_add_program(pio, &button_debounce_program);
+    uint mask = 0;
+    for (uint i = 0; i < count; ++i) {
+        gpio_init(pins[i]);
+        gpio_set_dir(pins[i], GPIO_IN);
+        gpio_pull_up(pins[i]);
+
+        btn_sm[i] = pio_claim_unused_sm(pio, true);
+        button_debounce_program_init(pio, btn_sm[i], offset, pins[i], BUTTONS_SAMPLE_HZ, debounce_us - 1);
+        pio_set_irq0_source_enabled(pio, pis_sm0_rx_fifo_not_empty + btn_sm[i], true);
+        mask |= 1u << btn_sm[i];
+    }
+
+    uint irq = pio_get_index(pio) ? PIO1_IRQ_0 : PIO0_IRQ_0;
+    irq_add_shared_handler(irq, buttons_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(irq, true);
+
+    // Todas as máquinas partem juntas: o relógio delas começa em start_us
+    start_us = time_us_32();
+    pio_enable_sm_mask_in_sync(pio, mask);
+}
+
+// Trocas de estado recebidas desde o início
+uint32_t buttons_events(void) {
+    return events;
+}
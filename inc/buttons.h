@@ -0,0 +1,27 @@
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Botões com debounce feito no PIO (button_debounce.pio), uma máquina por
+// botão. Repiques não geram interrupção: a CPU só vê a IRQ de FIFO não
+// vazio, uma por troca real de estado, com o instante da borda medido pelo
+// próprio PIO. Os botões são ativos em 0 com pull-up.
+
+#define BUTTONS_MAX 4               // Máquinas de um PIO
+#define BUTTONS_SAMPLE_HZ 1000000u  // Uma amostra por µs: carimbo em µs
+
+typedef struct {
+  uint8_t index;       // Posição do pino em buttons_init
+  bool pressed;
+  uint32_t edge_us;    // Início do nível estável (base de time_us_32)
+} button_event_t;
+
+// Chamado na IRQ do PIO para cada troca de estado
+typedef void (*buttons_callback_t)(const button_event_t *event);
+
+void buttons_init(PIO pio, const uint *pins, uint count, uint32_t debounce_us, buttons_callback_t callback);
+uint32_t buttons_events(void);
+
+#endif
@@ -0,0 +1,209 @@
+#include "entities.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Sprites por tipo, uma coluna por byte como na fonte; o centro fica em
+// (half, half) e o sprite inteiro cabe numa coluna de 8 pixels
+typedef struct {
+  uint8_t size, half;
+  uint8_t columns[5];
+} entity_sprite_t;
+
+static const entity_sprite_t entity_sprites[ENTITY_KINDS] = {
+    [ENTITY_TARGET] = {3, 1, {0x07, 0x07, 0x07}},
+    [ENTITY_OBSTACLE] = {5, 2, {0x1F, 0x11, 0x11, 0x11, 0x1F}},
+};
+
+// Distância de centro a centro abaixo da qual um alvo encosta num obstáculo
+#define ENTITY_CONTACT (1 + 2 + 1)
+_Static_assert(ENTITY_CONTACT <= ENTITY_MAX_RADIUS, "contato maior que o raio da busca na grade");
+
+void entities_init(entities_t *ents) {
+    memset(ents, 0, sizeof(*ents));
+}
+
+// Limites do centro de cada tipo: o sprite não toca a borda da tela
+static inline int32_t entity_min(uint8_t kind) {
+    return (entity_sprites[kind].half + 1) << ENTITY_FRAC;
+}
+
+static inline int32_t entity_max_x(uint8_t kind) {
+    return (SSD1306_WIDTH - 2 - entity_sprites[kind].half) << ENTITY_FRAC;
+}
+
+static inline int32_t entity_max_y(uint8_t kind) {
+    return (SSD1306_HEIGHT - 2 - entity_sprites[kind].half) << ENTITY_FRAC;
+}
+
+static inline int32_t entity_clamp(int32_t v, int32_t lo, int32_t hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+// Ordenação por contagem das entidades pela célula do centro
+static void entities_build_grid(entities_t *ents) {
+    uint8_t cell[ENTITIES_MAX];
+    uint8_t fill[ENTITY_GRID_CELLS + 1];
+    memset(fill, 0, sizeof(fill));
+    for (uint8_t i = 0; i < ents->count; ++i) {
+        cell[i] = (ents->py[i] >> ENTITY_CELL_SHIFT) * ENTITY_GRID_W + (ents->px[i] >> ENTITY_CELL_SHIFT);
+        fill[cell[i] + 1]++;
+    }
+    for (int c = 0; c < ENTITY_GRID_CELLS; ++c)
+        fill[c + 1] += fill[c];
+    memcpy(ents->cell_start, fill, sizeof(ents->cell_start));
+    for (uint8_t i = 0; i < ents->count; ++i)
+        ents->cell_items[fill[cell[i]]++] = i;
+}
+
+// Entidade do tipo pedido mais próxima de (x, y) com |dx| e |dy| < radius,
+// olhando só as células que a caixa cobre; radius até ENTITY_MAX_RADIUS
+static int entities_nearest(const entities_t *ents, int16_t x, int16_t y, uint8_t radius, uint8_t kind) {
+    if (radius > ENTITY_MAX_RADIUS) radius = ENTITY_MAX_RADIUS;
+    int16_t x0 = x - radius + 1, x1 = x + radius - 1;
+    int16_t y0 = y - radius + 1, y1 = y + radius - 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > SSD1306_WIDTH - 1) x1 = SSD1306_WIDTH - 1;
+    if (y1 > SSD1306_HEIGHT - 1) y1 = SSD1306_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return ENTITY_NONE;
+
+    int best = ENTITY_NONE;
+    int best_dist = radius;
+    for (int cy = y0 >> ENTITY_CELL_SHIFT; cy <= y1 >> ENTITY_CELL_SHIFT; ++cy) {
+        for (int cx = x0 >> ENTITY_CELL_SHIFT; cx <= x1 >> ENTITY_CELL_SHIFT; ++cx) {
+            int c = cy * ENTITY_GRID_W + cx;
+            for (int k = ents->cell_start[c]; k < ents->cell_start[c + 1]; ++k) {
+                uint8_t i = ents->cell_items[k];
+                if (ents->kind[i] != kind) continue;
+                int dx = abs(ents->px[i] - x), dy = abs(ents->py[i] - y);
+                int dist = dx > dy ? dx : dy;
+                if (dist < best_dist) {
+                    best = i;
+                    best_dist = dist;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Nova entidade com centro em (x, y) pixels e velocidade em Q8 por passo.
+// Retorna o índice, ou ENTITY_NONE se o conjunto está cheio. Os índices
+// são densos: remover uma entidade move a última para o lugar dela.
+int entities_spawn(entities_t *ents, entity_kind_t kind, uint8_t x, uint8_t y, int16_t vx, int16_t vy) {
+    if (ents->count >= ENTITIES_MAX || kind >= ENTITY_KINDS) return ENTITY_NONE;
+    uint8_t i = ents->count++;
+    ents->kind[i] = kind;
+    ents->x[i] = entity_clamp((int32_t)x << ENTITY_FRAC, entity_min(kind), entity_max_x(kind));
+    ents->y[i] = entity_clamp((int32_t)y << ENTITY_FRAC, entity_min(kind), entity_max_y(kind));
+    ents->vx[i] = vx;
+    ents->vy[i] = vy;
+    ents->px[i] = ents->x[i] >> ENTITY_FRAC;
+    ents->py[i] = ents->y[i] >> ENTITY_FRAC;
+    entities_build_grid(ents);
+    return i;
+}
+
+void entities_remove(entities_t *ents, int index) {
+    if (index < 0 || index >= ents->count) return;
+    uint8_t last = --ents->count;
+    ents->x[index] = ents->x[last];
+    ents->y[index] = ents->y[last];
+    ents->vx[index] = ents->vx[last];
+    ents->vy[index] = ents->vy[last];
+    ents->kind[index] = ents->kind[last];
+    ents->px[index] = ents->px[last];
+    ents->py[index] = ents->py[last];
+    entities_build_grid(ents);
+}
+
+// Reflete a coordenada nas paredes, invertendo a velocidade
+static inline void entity_bounce(int32_t *pos, int16_t *vel, int32_t lo, int32_t hi) {
+    if (*pos < lo) {
+        *pos = 2 * lo - *pos;
+        *vel = -*vel;
+    } else if (*pos > hi) {
+        *pos = 2 * hi - *pos;
+        *vel = -*vel;
+    }
+    *pos = entity_clamp(*pos, lo, hi);
+}
+
+// Alvo encostado num obstáculo: sai pelo eixo de menor penetração e passa a
+// se afastar dele nesse eixo
+static void entities_collide(entities_t *ents, uint8_t t, uint8_t o) {
+    int dx = ents->px[t] - ents->px[o], dy = ents->py[t] - ents->py[o];
+    if (ENTITY_CONTACT - abs(dx) <= ENTITY_CONTACT - abs(dy)) {
+        int side = dx >= 0 ? 1 : -1;
+        ents->x[t] = (int32_t)(ents->px[o] + side * ENTITY_CONTACT) << ENTITY_FRAC;
+        ents->vx[t] = side * abs(ents->vx[t]);
+    } else {
+        int side = dy >= 0 ? 1 : -1;
+        ents->y[t] = (int32_t)(ents->py[o] + side * ENTITY_CONTACT) << ENTITY_FRAC;
+        ents->vy[t] = side * abs(ents->vy[t]);
+    }
+    ents->x[t] = entity_clamp(ents->x[t], entity_min(ENTITY_TARGET), entity_max_x(ENTITY_TARGET));
+    ents->y[t] = entity_clamp(ents->y[t], entity_min(ENTITY_TARGET), entity_max_y(ENTITY_TARGET));
+    ents->px[t] = ents->x[t] >> ENTITY_FRAC;
+    ents->py[t] = ents->y[t] >> ENTITY_FRAC;
+    ents->bounces++;
+}
+
+// Um passo fixo: integra, ricocheteia nas paredes, remonta a grade e resolve
+// os contatos entre alvos e obstáculos
+void entities_step(entities_t *ents) {
+    uint8_t n = ents->count;
+    for (uint8_t i = 0; i < n; ++i) {
+        ents->x[i] += ents->vx[i];
+        ents->y[i] += ents->vy[i];
+    }
+    for (uint8_t i = 0; i < n; ++i) {
+        uint8_t kind = ents->kind[i];
+        entity_bounce(&ents->x[i], &ents->vx[i], entity_min(kind), entity_max_x(kind));
+        entity_bounce(&ents->y[i], &ents->vy[i], entity_min(kind), entity_max_y(kind));
+    }
+    for (uint8_t i = 0; i < n; ++i) {
+        ents->px[i] = ents->x[i] >> ENTITY_FRAC;
+        ents->py[i] = ents->y[i] >> ENTITY_FRAC;
+    }
+    entities_build_grid(ents);
+
+    uint32_t bounces = ents->bounces;
+    for (uint8_t i = 0; i < n; ++i) {
+        if (ents->kind[i] != ENTITY_TARGET) continue;
+        int o = entities_nearest(ents, ents->px[i], ents->py[i], ENTITY_CONTACT, ENTITY_OBSTACLE);
+        if (o != ENTITY_NONE) entities_collide(ents, i, o);
+    }
+    if (ents->bounces != bounces) entities_build_grid(ents);
+    ents->steps++;
+}
+
+// Alvo sob o cursor, pela mesma regra do jogo (|dx| e |dy| < radius, com
+// radius limitado a ENTITY_MAX_RADIUS); o mais próximo se houver mais de um.
+// ENTITY_NONE se nenhum.
+int entities_hit(const entities_t *ents, uint8_t x, uint8_t y, uint8_t radius) {
+    return entities_nearest(ents, x, y, radius, ENTITY_TARGET);
+}
+
+// Aplica (OR) os sprites no framebuffer, um tipo por vez. O centro de cada
+// entidade fica longe da borda, então não há recorte por pixel: cada coluna
+// é um byte deslocado, espalhado por no máximo duas páginas.
+void entities_render(const entities_t *ents, ssd1306_t *ssd) {
+    uint8_t *fb = ssd->ram_buffer;
+    for (uint8_t kind = 0; kind < ENTITY_KINDS; ++kind) {
+        const entity_sprite_t *sprite = &entity_sprites[kind];
+        for (uint8_t i = 0; i < ents->count; ++i) {
+            if (ents->kind[i] != kind) continue;
+            uint8_t x0 = ents->px[i] - sprite->half;
+            uint8_t y0 = ents->py[i] - sprite->half;
+            uint8_t page = y0 >> 3, shift = y0 & 7;
+            bool spill = shift + sprite->size > 8;
+            for (uint8_t c = 0; c < sprite->size; ++c) {
+                uint16_t bits = (uint16_t)sprite->columns[c] << shift;
+                uint8_t *col = &fb[SSD1306_INDEX(x0 + c, page)];
+                col[0] |= (uint8_t)bits;
+                if (spill) col[1] |= (uint8_t)(bits >> 8);
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Conjunto de entidades (alvos e obstáculos móveis) para modos de jogo com
+// muitos objetos na tela. Os dados ficam em estrutura de vetores: cada campo
+// é um vetor denso indexado pela entidade, e cada laço (física, grade,
+// desenho) percorre só os campos que usa. A física é de passo fixo em
+// inteiros (Q8); depois de cada passo uma grade uniforme de células de 8x8
+// pixels é remontada por ordenação por contagem, e o teste de acerto do
+// cursor olha no máximo 2x2 células, independente do número de entidades.
+// Os sprites são aplicados direto no framebuffer, uma coluna por byte (duas
+// quando cruzam uma página), agrupados por tipo.
+// Não depende do SDK; sem alocação dinâmica. Nenhum modo do firmware usa
+// ainda: por enquanto é compilado só na biblioteca de host.
+
+#define ENTITIES_MAX 128
+#define ENTITY_FRAC 8                 // Bits fracionários de posição e velocidade
+#define ENTITY_ONE (1 << ENTITY_FRAC)
+#define ENTITY_STEP_MS 20             // Passo fixo pensado para a física (50 Hz)
+#define ENTITY_NONE (-1)
+
+#define ENTITY_CELL_SHIFT 3           // Células de 8x8 pixels
+#define ENTITY_MAX_RADIUS (1 << (ENTITY_CELL_SHIFT - 1))  // Meia célula: a caixa cobre até 2x2 células
+#define ENTITY_GRID_W (SSD1306_WIDTH >> ENTITY_CELL_SHIFT)
+#define ENTITY_GRID_H (SSD1306_HEIGHT >> ENTITY_CELL_SHIFT)
+#define ENTITY_GRID_CELLS (ENTITY_GRID_W * ENTITY_GRID_H)
+
+_Static_assert(ENTITIES_MAX <= 255, "índices das células são de 8 bits");
+
+typedef enum {
+  ENTITY_TARGET,    // Marcador 3x3; o cursor acerta
+  ENTITY_OBSTACLE,  // Caixa 5x5; os alvos ricocheteiam nela
+  ENTITY_KINDS
+} entity_kind_t;
+
+typedef struct {
+  uint8_t count;
+  // Estado, um vetor por campo
+  int32_t x[ENTITIES_MAX], y[ENTITIES_MAX];    // Centro, Q8
+  int16_t vx[ENTITIES_MAX], vy[ENTITIES_MAX];  // Q8 por passo
+  uint8_t kind[ENTITIES_MAX];
+  uint8_t px[ENTITIES_MAX], py[ENTITIES_MAX];  // Centro em pixels, do último passo
+  // Grade: entidades ordenadas por célula; as da célula c estão em
+  // cell_items[cell_start[c] .. cell_start[c + 1] - 1]
+  uint8_t cell_start[ENTITY_GRID_CELLS + 1];
+  uint8_t cell_items[ENTITIES_MAX];
+  uint32_t steps;
+  uint32_t bounces;  // Ricochetes em obstáculos
+} entities_t;
+
+void entities_init(entities_t *ents);
+int entities_spawn(entities_t *ents, entity_kind_t kind, uint8_t x, uint8_t y, int16_t vx, int16_t vy);
+void entities_remove(entities_t *ents, int index);
+void entities_step(entities_t *ents);
+int entities_hit(const entities_t *ents, uint8_t x, uint8_t y, uint8_t radius);
+void entities_render(const entities_t *ents, ssd1306_t *ssd);
+
+#endif
@@ -0,0 +1,41 @@
+#include "event_queue.h"
+#include "hardware/sync.h"
+
+static event_t ring[EVENT_QUEUE_SIZE];
+static volatile uint32_t head = 0;  // Escrito apenas pelo produtor
+static volatile uint32_t tail = 0;  // Escrito apenas pelo consumidor
+static volatile uint32_t dropped = 0;
+
+// Chamada em contexto de interrupção
+bool event_queue_push(event_type_t type) {
+    return event_queue_push_at(type, time_us_32());
+}
+
+// Evento com o instante em que aconteceu, quando a fonte o mediu
+bool event_queue_push_at(event_type_t type, uint32_t timestamp_us) {
+    uint32_t h = head;
+    if (h - tail == EVENT_QUEUE_SIZE) {
+        dropped++;
+        return false;
+    }
+    ring[h & (EVENT_QUEUE_SIZE - 1)].type = type;
+    ring[h & (EVENT_QUEUE_SIZE - 1)].timestamp_us = timestamp_us;
+    __dmb();  // Publica o evento antes de avançar o índice
+    head = h + 1;
+    __sev();  // Acorda o loop principal parado em __wfe()
+    return true;
+}
+
+bool event_queue_pop(event_t *event) {
+    uint32_t t = tail;
+    if (t == head) return false;
+    __dmb();
+    *event = ring[t & (EVENT_QUEUE_SIZE - 1)];
+    __dmb();  // Libera a posição só depois da cópia
+    tail = t + 1;
+    return true;
+}
+
+uint32_t event_queue_dropped(void) {
+    return dropped;
+}
@@ -0,0 +1,33 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include "pico/stdlib.h"
+
+// Fila de eventos sem travas (um produtor, um consumidor).
+// Produtor: rotinas de interrupção (PIO dos botões e alarme dos
+// temporizadores). Todas usam a prioridade padrão de IRQ e por isso não se
+// aninham, formando um único produtor.
+// Consumidor: o loop principal em main().
+
+#define EVENT_QUEUE_SIZE 32  // Deve ser potência de 2
+
+typedef enum {
+  EVENT_TICK,            // Período do jogo (timer repetitivo)
+  EVENT_BUTTON_A,        // Pausa / retoma
+  EVENT_BUTTON_B,        // Reinicia a partida
+  EVENT_JOYSTICK_CLICK,  // Clique no alvo
+  EVENT_GAME_RESET,      // Fim da tela de vitória/derrota
+  EVENT_FLASH_COMMIT     // Tela final parada: ponto seguro para gravar a flash
+} event_type_t;
+
+typedef struct {
+  uint8_t type;
+  uint32_t timestamp_us;
+} event_t;
+
+bool event_queue_push(event_type_t type);
+bool event_queue_push_at(event_type_t type, uint32_t timestamp_us);
+bool event_queue_pop(event_t *event);
+uint32_t event_queue_dropped(void);
+
+#endif
@@ -0,0 +1,256 @@
+#include "fb_mirror.h"
+#include <string.h>
+
+// CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF), bit a bit
+static uint16_t fb_mirror_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+void fb_mirror_init(fb_mirror_t *mirror, fb_mirror_write_t write, void *user_data) {
+    memset(mirror->prev, 0, sizeof(mirror->prev));
+    mirror->packet_len = 0;
+    mirror->pos = 0;
+    mirror->active = false;
+    mirror->keyframe = false;
+    mirror->first_packet = false;
+    mirror->force_keyframe = true;
+    mirror->frame_seq = 0;
+    mirror->packet_seq = 0;
+    mirror->since_keyframe = 0;
+    mirror->frames = 0;
+    mirror->bytes_out = 0;
+    mirror->write = write;
+    mirror->user_data = user_data;
+}
+
+bool fb_mirror_busy(const fb_mirror_t *mirror) {
+    return mirror->active;
+}
+
+void fb_mirror_request_keyframe(fb_mirror_t *mirror) {
+    mirror->force_keyframe = true;
+}
+
+// Copia o quadro a espelhar; a codificação acontece nos passos seguintes.
+// Retorna false se o quadro anterior ainda não terminou.
+bool fb_mirror_begin(fb_mirror_t *mirror, const uint8_t *frame) {
+    if (mirror->active) return false;
+
+    memcpy(mirror->cur, frame, SSD1306_FB_SIZE);
+    mirror->keyframe = mirror->force_keyframe || mirror->since_keyframe >= FB_MIRROR_KEYFRAME_INTERVAL;
+    if (mirror->keyframe) {
+        memset(mirror->prev, 0, sizeof(mirror->prev));
+        mirror->force_keyframe = false;
+        mirror->since_keyframe = 0;
+    }
+    mirror->since_keyframe++;
+    mirror->frame_seq++;
+    mirror->pos = 0;
+    mirror->first_packet = true;
+    mirror->active = true;
+    return true;
+}
+
+static inline uint8_t fb_mirror_delta(const fb_mirror_t *mirror, uint16_t i) {
+    return mirror->cur[i] ^ mirror->prev[i];
+}
+
+// Codifica os bytes [start, end) do quadro como tokens; retorna o tamanho.
+// Um literal só é interrompido por dois bytes sem mudança ou por uma
+// repetição de pelo menos 3, que saem mais baratos como tokens próprios.
+static size_t fb_mirror_encode(const fb_mirror_t *mirror, uint16_t start, uint16_t end, uint8_t *out) {
+    size_t n = 0;
+    uint16_t i = start;
+    while (i < end) {
+        uint8_t value = fb_mirror_delta(mirror, i);
+
+        if (value == 0) {
+            uint16_t j = i;
+            while (j < end && fb_mirror_delta(mirror, j) == 0) j++;
+            if (j == end) break;  // Sem mudança até o fim do pacote
+            while (i < j) {
+                uint16_t run = (j - i > 128) ? 128 : j - i;
+                out[n++] = (uint8_t)(run - 1);
+                i += run;
+            }
+            continue;
+        }
+
+        uint16_t run = 1;
+        while (i + run < end && run < 64 && fb_mirror_delta(mirror, i + run) == value) run++;
+        if (run >= 3) {
+            out[n++] = 0xC0 | (uint8_t)(run - 1);
+            out[n++] = value;
+            i += run;
+            continue;
+        }
+
+        uint16_t j = i + 1;
+        while (j < end && j - i < 64) {
+            uint8_t next = fb_mirror_delta(mirror, j);
+            if (next == 0 && (j + 1 >= end || fb_mirror_delta(mirror, j + 1) == 0)) break;
+            if (j + 2 < end && next == fb_mirror_delta(mirror, j + 1) && next == fb_mirror_delta(mirror, j + 2)) break;
+            j++;
+        }
+        out[n++] = 0x80 | (uint8_t)(j - i - 1);
+        while (i < j) out[n++] = fb_mirror_delta(mirror, i++);
+    }
+    return n;
+}
+
+// Monta o pacote do próximo trecho do quadro, se houver mudança nele
+static void fb_mirror_build_packet(fb_mirror_t *mirror) {
+    uint16_t start = mirror->pos;
+    uint16_t end = start + FB_MIRROR_STEP < SSD1306_FB_SIZE ? start + FB_MIRROR_STEP : SSD1306_FB_SIZE;
+    bool last = end == SSD1306_FB_SIZE;
+
+    // Bytes sem mudança no começo viram deslocamento do offset
+    uint16_t offset = start;
+    while (offset < end && fb_mirror_delta(mirror, offset) == 0) offset++;
+
+    uint8_t *p = mirror->packet;
+    size_t payload = fb_mirror_encode(mirror, offset, end, p + FB_MIRROR_HEADER);
+    mirror->pos = end;
+    if (payload == 0 && !last) return;
+
+    p[0] = FB_MIRROR_SYNC0;
+    p[1] = FB_MIRROR_SYNC1;
+    p[2] = (mirror->keyframe ? FB_MIRROR_KEYFRAME : 0) | (last ? FB_MIRROR_LAST : 0) |
+           (mirror->first_packet ? FB_MIRROR_FIRST : 0);
+    mirror->first_packet = false;
+    p[3] = mirror->frame_seq;
+    p[4] = mirror->packet_seq++;
+    p[5] = offset & 0xFF;
+    p[6] = offset >> 8;
+    p[7] = (uint8_t)payload;
+    uint16_t crc = fb_mirror_crc16(p + 2, FB_MIRROR_HEADER - 2 + payload);
+    p[FB_MIRROR_HEADER + payload] = crc & 0xFF;
+    p[FB_MIRROR_HEADER + payload + 1] = crc >> 8;
+    mirror->packet_len = FB_MIRROR_HEADER + payload + 2;
+}
+
+// Um passo: entrega o pacote pendente ou codifica o próximo trecho.
+// Retorna true enquanto o quadro atual não terminou.
+bool fb_mirror_step(fb_mirror_t *mirror) {
+    if (!mirror->active) return false;
+
+    if (mirror->packet_len == 0) {
+        if (mirror->pos < SSD1306_FB_SIZE)
+            fb_mirror_build_packet(mirror);
+        if (mirror->packet_len == 0) return true;  // Trecho sem mudança
+    }
+
+    if (!mirror->write(mirror->packet, mirror->packet_len, mirror->user_data))
+        return true;
+    mirror->bytes_out += mirror->packet_len;
+    mirror->packet_len = 0;
+
+    if (mirror->pos == SSD1306_FB_SIZE) {
+        memcpy(mirror->prev, mirror->cur, SSD1306_FB_SIZE);
+        mirror->frames++;
+        mirror->active = false;
+    }
+    return mirror->active;
+}
+
+void fb_mirror_decoder_init(fb_mirror_decoder_t *decoder) {
+    memset(decoder, 0, sizeof(*decoder));
+}
+
+// Aplica os tokens de um pacote válido ao quadro
+static bool fb_mirror_apply(fb_mirror_decoder_t *decoder, uint16_t offset, const uint8_t *tokens, uint8_t len) {
+    uint16_t i = offset;
+    uint8_t k = 0;
+    while (k < len) {
+        uint8_t c = tokens[k++];
+        uint16_t run = (c < 0x80) ? c + 1 : (c & 0x3F) + 1;
+        if (i + run > SSD1306_FB_SIZE) return false;
+        if (c < 0x80) {
+            i += run;
+        } else if (c < 0xC0) {
+            if (k + run > len) return false;
+            while (run--) decoder->frame[i++] ^= tokens[k++];
+        } else {
+            if (k >= len) return false;
+            uint8_t value = tokens[k++];
+            while (run--) decoder->frame[i++] ^= value;
+        }
+    }
+    return true;
+}
+
+// Trata um pacote completo; retorna true se ele fechou um quadro válido
+static bool fb_mirror_packet(fb_mirror_decoder_t *decoder) {
+    const uint8_t *p = decoder->buf;
+    uint8_t len = p[5];
+    uint16_t crc = p[6 + len] | (p[7 + len] << 8);
+    if (fb_mirror_crc16(p, 6 + len) != crc) {
+        decoder->crc_errors++;
+        return false;
+    }
+
+    uint8_t flags = p[0];
+    uint8_t frame_seq = p[1];
+    uint8_t packet_seq = p[2];
+    uint16_t offset = p[3] | (p[4] << 8);
+
+    if (decoder->packets > 0 && packet_seq != (uint8_t)(decoder->packet_seq + 1)) {
+        decoder->lost_packets += (uint8_t)(packet_seq - decoder->packet_seq - 1);
+        decoder->synced = false;
+    }
+    decoder->packets++;
+    decoder->packet_seq = packet_seq;
+    decoder->bytes_in += FB_MIRROR_HEADER + len + 2;
+
+    // Início de um quadro-chave: recomeça do zero e volta a ficar sincronizado
+    if ((flags & FB_MIRROR_KEYFRAME) && (flags & FB_MIRROR_FIRST)) {
+        memset(decoder->frame, 0, sizeof(decoder->frame));
+        decoder->synced = true;
+    }
+    decoder->frame_seq = frame_seq;
+
+    if (!fb_mirror_apply(decoder, offset, p + 6, len))
+        decoder->synced = false;
+
+    if ((flags & FB_MIRROR_LAST) && decoder->synced) {
+        decoder->frames++;
+        return true;
+    }
+    return false;
+}
+
+// Consome um byte do canal; bytes fora de pacotes (texto) são ignorados.
+// Retorna true quando decoder->frame contém um quadro completo.
+bool fb_mirror_decode(fb_mirror_decoder_t *decoder, uint8_t byte) {
+    if (decoder->need == 0) {
+        // Procurando A5 5A; len conta quantos bytes do sincronismo já vieram
+        if (decoder->len == 1 && byte == FB_MIRROR_SYNC1) {
+            decoder->len = 0;
+            decoder->need = FB_MIRROR_HEADER - 2;
+        } else {
+            decoder->len = (byte == FB_MIRROR_SYNC0);
+        }
+        return false;
+    }
+
+    decoder->buf[decoder->len++] = byte;
+    if (decoder->len == FB_MIRROR_HEADER - 2) {
+        if (decoder->buf[5] > FB_MIRROR_MAX_PAYLOAD) {
+            decoder->len = 0;
+            decoder->need = 0;
+            return false;
+        }
+        decoder->need += decoder->buf[5] + 2;
+    }
+    if (decoder->len < decoder->need) return false;
+
+    decoder->len = 0;
+    decoder->need = 0;
+    return fb_mirror_packet(decoder);
+}
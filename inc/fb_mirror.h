@@ -0,0 +1,76 @@
+#ifndef FB_MIRROR_H
+#define FB_MIRROR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306.h"
+
+// Espelhamento do framebuffer do display por um canal de bytes (USB CDC).
+// Cada quadro é o XOR contra o quadro espelhado anterior, codificado em
+// corridas (RLE) e dividido em pacotes com sincronismo e CRC-16, que podem
+// dividir o canal com texto comum. O codificador trabalha em passos de
+// FB_MIRROR_STEP bytes do quadro, então nunca para a renderização por um
+// quadro inteiro. Não depende do SDK: a saída é um callback.
+//
+// Pacote: A5 5A | flags | quadro | pacote | offset (LE, 16 bits) | n |
+//         n bytes de tokens | CRC-16/CCITT (LE) de flags até os tokens
+// Tokens, aplicados a partir do offset:
+//   0x00-0x7F  c + 1 bytes sem mudança
+//   0x80-0xBF  (c & 0x3F) + 1 bytes literais de XOR em seguida
+//   0xC0-0xFF  (c & 0x3F) + 1 repetições do byte de XOR seguinte
+// Bytes sem mudança no fim de um pacote e pacotes sem mudança são omitidos.
+
+#define FB_MIRROR_SYNC0 0xA5
+#define FB_MIRROR_SYNC1 0x5A
+#define FB_MIRROR_KEYFRAME 0x01  // XOR contra zero: o decodificador zera o quadro
+#define FB_MIRROR_LAST 0x02      // Último pacote do quadro
+#define FB_MIRROR_FIRST 0x04     // Primeiro pacote do quadro
+
+#define FB_MIRROR_STEP 128                // Bytes do quadro por passo
+#define FB_MIRROR_KEYFRAME_INTERVAL 32    // Quadros entre quadros-chave
+#define FB_MIRROR_HEADER 8
+#define FB_MIRROR_MAX_PAYLOAD (FB_MIRROR_STEP + FB_MIRROR_STEP / 64 + 1)
+#define FB_MIRROR_MAX_PACKET (FB_MIRROR_HEADER + FB_MIRROR_MAX_PAYLOAD + 2)
+
+// Retorna false se o canal não tem espaço; o pacote é tentado de novo depois
+typedef bool (*fb_mirror_write_t)(const uint8_t *data, size_t len, void *user_data);
+
+typedef struct {
+  uint8_t prev[SSD1306_FB_SIZE];  // Último quadro espelhado
+  uint8_t cur[SSD1306_FB_SIZE];   // Quadro em codificação
+  uint8_t packet[FB_MIRROR_MAX_PACKET];
+  size_t packet_len;              // Pacote pronto esperando o canal
+  uint16_t pos;                   // Próximo byte do quadro a codificar
+  bool active;
+  bool keyframe;
+  bool first_packet;
+  bool force_keyframe;
+  uint8_t frame_seq, packet_seq;
+  uint8_t since_keyframe;
+  uint32_t frames;
+  uint32_t bytes_out;             // Bytes de pacotes entregues ao canal
+  fb_mirror_write_t write;
+  void *user_data;
+} fb_mirror_t;
+
+typedef struct {
+  uint8_t frame[SSD1306_FB_SIZE];
+  uint8_t buf[FB_MIRROR_MAX_PACKET];
+  size_t len, need;
+  bool synced;       // Quadro válido: houve quadro-chave e nenhum pacote perdido
+  uint8_t frame_seq, packet_seq;
+  uint32_t frames, packets, crc_errors, lost_packets;
+  uint64_t bytes_in; // Bytes de pacotes válidos
+} fb_mirror_decoder_t;
+
+void fb_mirror_init(fb_mirror_t *mirror, fb_mirror_write_t write, void *user_data);
+bool fb_mirror_busy(const fb_mirror_t *mirror);
+bool fb_mirror_begin(fb_mirror_t *mirror, const uint8_t *frame);
+void fb_mirror_request_keyframe(fb_mirror_t *mirror);
+bool fb_mirror_step(fb_mirror_t *mirror);
+
+void fb_mirror_decoder_init(fb_mirror_decoder_t *decoder);
+bool fb_mirror_decode(fb_mirror_decoder_t *decoder, uint8_t byte);
+
+#endif
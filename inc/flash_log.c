@@ -0,0 +1,248 @@
+#include "flash_log.h"
+#include <string.h>
+
+// Maior trecho gravado num commit: todos os tipos a partir de qualquer
+// posição de uma página
+#define FLASH_LOG_BUF_PAGES 3
+_Static_assert(HAL_FLASH_PAGE_SIZE - 4 + FLASH_LOG_TYPES * (FLASH_LOG_RECORD_HEADER + FLASH_LOG_MAX_PAYLOAD) <=
+                   FLASH_LOG_BUF_PAGES * HAL_FLASH_PAGE_SIZE,
+               "buffer de gravação pequeno");
+
+static uint8_t flash_log_buf[FLASH_LOG_BUF_PAGES * HAL_FLASH_PAGE_SIZE];
+
+// CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF), bit a bit
+static uint16_t flash_log_crc16(uint16_t crc, const uint8_t *data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; ++i)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static inline uint32_t flash_log_record_size(uint8_t len) {
+    return FLASH_LOG_RECORD_HEADER + ((len + 3u) & ~3u);
+}
+
+static inline uint32_t flash_log_sector(const flash_log_t *log, uint8_t sector) {
+    return log->offset + sector * HAL_FLASH_SECTOR_SIZE;
+}
+
+static inline uint8_t flash_log_next(const flash_log_t *log) {
+    return (log->active + 1) % log->sectors;
+}
+
+static bool flash_log_blank(uint32_t offset, uint32_t len) {
+    const uint8_t *p = hal_flash_read(offset);
+    for (uint32_t i = 0; i < len; ++i) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+static uint32_t flash_log_read32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void flash_log_write32(uint8_t *p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+// Sequência do setor, ou false se o cabeçalho não vale
+static bool flash_log_header(const flash_log_t *log, uint8_t sector, uint32_t *seq) {
+    const uint8_t *p = hal_flash_read(flash_log_sector(log, sector));
+    if (flash_log_read32(p) != FLASH_LOG_MAGIC) return false;
+    uint16_t crc = p[FLASH_LOG_HEADER - 2] | (p[FLASH_LOG_HEADER - 1] << 8);
+    if (flash_log_crc16(0xFFFF, p, FLASH_LOG_HEADER - 2) != crc) return false;
+    *seq = flash_log_read32(p + 4);
+    return true;
+}
+
+// Carrega os registros do setor ativo para a RAM; a última versão de cada
+// tipo prevalece. Para no espaço livre ou num cabeçalho de registro
+// impossível (o resto do setor não é mais usado).
+static void flash_log_scan(flash_log_t *log) {
+    uint32_t base = flash_log_sector(log, log->active);
+    const uint8_t *sector = hal_flash_read(base);
+    uint32_t pos = FLASH_LOG_HEADER;
+    while (pos + FLASH_LOG_RECORD_HEADER <= HAL_FLASH_SECTOR_SIZE) {
+        const uint8_t *p = sector + pos;
+        if (p[0] == FLASH_LOG_EMPTY) break;
+        uint32_t size = flash_log_record_size(p[1]);
+        if (p[0] >= FLASH_LOG_TYPES || p[1] > FLASH_LOG_MAX_PAYLOAD || pos + size > HAL_FLASH_SECTOR_SIZE) {
+            log->bad_records++;
+            pos = HAL_FLASH_SECTOR_SIZE;
+            break;
+        }
+        uint16_t crc = flash_log_crc16(flash_log_crc16(0xFFFF, p, 2), p + FLASH_LOG_RECORD_HEADER, p[1]);
+        if (crc == (p[2] | (p[3] << 8))) {
+            memcpy(log->data[p[0]], p + FLASH_LOG_RECORD_HEADER, p[1]);
+            log->len[p[0]] = p[1];
+            log->valid |= 1u << p[0];
+            log->recovered++;
+        } else {
+            log->bad_records++;
+        }
+        pos += size;
+    }
+    log->write_pos = pos;
+}
+
+// Recuperação na partida: lê um cabeçalho por setor e percorre só o setor
+// de sequência mais alta. Sem setor válido, o primeiro commit formata.
+void flash_log_init(flash_log_t *log, uint32_t offset, uint8_t sectors) {
+    memset(log, 0, sizeof(*log));
+    log->offset = offset;
+    log->sectors = sectors < 2 ? 2 : sectors > FLASH_LOG_MAX_SECTORS ? FLASH_LOG_MAX_SECTORS : sectors;
+
+    bool found = false;
+    for (uint8_t s = 0; s < log->sectors; ++s) {
+        uint32_t seq;
+        if (!flash_log_header(log, s, &seq)) continue;
+        if (!found || (int32_t)(seq - log->seq) > 0) {
+            log->active = s;
+            log->seq = seq;
+            found = true;
+        }
+    }
+
+    if (found) {
+        flash_log_scan(log);
+    } else {
+        // O setor 0 será o primeiro ativo
+        log->active = log->sectors - 1;
+        log->write_pos = HAL_FLASH_SECTOR_SIZE;
+    }
+    log->next_erased = flash_log_blank(flash_log_sector(log, flash_log_next(log)), HAL_FLASH_SECTOR_SIZE);
+}
+
+// Copia a versão atual do tipo; false se não há versão com esse tamanho
+bool flash_log_get(const flash_log_t *log, uint8_t type, void *data, uint8_t len) {
+    if (type >= FLASH_LOG_TYPES || !(log->valid & (1u << type)) || log->len[type] != len) return false;
+    memcpy(data, log->data[type], len);
+    return true;
+}
+
+// Nova versão do tipo, só em RAM até o próximo commit. Gravar a mesma
+// versão de novo não gera escrita.
+bool flash_log_put(flash_log_t *log, uint8_t type, const void *data, uint8_t len) {
+    if (type >= FLASH_LOG_TYPES || len > FLASH_LOG_MAX_PAYLOAD) return false;
+    uint8_t bit = 1u << type;
+    if ((log->valid & bit) && log->len[type] == len && !memcmp(log->data[type], data, len)) return true;
+    memcpy(log->data[type], data, len);
+    log->len[type] = len;
+    log->valid |= bit;
+    log->dirty |= bit;
+    return true;
+}
+
+// Há algo para gravar ou apagar no próximo commit
+bool flash_log_pending(const flash_log_t *log) {
+    return log->dirty || !log->next_erased;
+}
+
+// Bytes livres no setor ativo
+uint32_t flash_log_free(const flash_log_t *log) {
+    return HAL_FLASH_SECTOR_SIZE - log->write_pos;
+}
+
+// Serializa os tipos da máscara em buf; retorna os bytes usados
+static uint32_t flash_log_pack(const flash_log_t *log, uint8_t mask, uint8_t *buf) {
+    uint32_t pos = 0;
+    for (uint8_t type = 0; type < FLASH_LOG_TYPES; ++type) {
+        if (!(mask & (1u << type))) continue;
+        uint8_t *p = buf + pos;
+        uint8_t len = log->len[type];
+        p[0] = type;
+        p[1] = len;
+        memcpy(p + FLASH_LOG_RECORD_HEADER, log->data[type], len);
+        uint16_t crc = flash_log_crc16(flash_log_crc16(0xFFFF, p, 2), p + FLASH_LOG_RECORD_HEADER, len);
+        p[2] = crc & 0xFF;
+        p[3] = crc >> 8;
+        pos += flash_log_record_size(len);
+    }
+    return pos;
+}
+
+static uint32_t flash_log_size(const flash_log_t *log, uint8_t mask) {
+    uint32_t size = 0;
+    for (uint8_t type = 0; type < FLASH_LOG_TYPES; ++type) {
+        if (mask & (1u << type)) size += flash_log_record_size(log->len[type]);
+    }
+    return size;
+}
+
+static inline uint32_t flash_log_pages(uint32_t len) {
+    return (len + HAL_FLASH_PAGE_SIZE - 1) & ~(HAL_FLASH_PAGE_SIZE - 1);
+}
+
+static void flash_log_erase_next(flash_log_t *log) {
+    hal_flash_erase(flash_log_sector(log, flash_log_next(log)), HAL_FLASH_SECTOR_SIZE);
+    log->next_erased = true;
+    log->erases++;
+}
+
+// Passa para o próximo setor, já apagado, com a versão atual de todos os
+// tipos. O cabeçalho entra numa segunda gravação da primeira página: até
+// ela, o setor não vale e a partida continua usando o anterior.
+static void flash_log_rotate(flash_log_t *log) {
+    uint8_t sector = flash_log_next(log);
+    uint32_t base = flash_log_sector(log, sector);
+    uint32_t seq = log->seq + 1;
+
+    memset(flash_log_buf, 0xFF, sizeof(flash_log_buf));
+    uint32_t used = FLASH_LOG_HEADER + flash_log_pack(log, log->valid, flash_log_buf + FLASH_LOG_HEADER);
+    if (used > FLASH_LOG_HEADER)
+        hal_flash_program(base, flash_log_buf, flash_log_pages(used));
+
+    flash_log_write32(flash_log_buf, FLASH_LOG_MAGIC);
+    flash_log_write32(flash_log_buf + 4, seq);
+    uint16_t crc = flash_log_crc16(0xFFFF, flash_log_buf, FLASH_LOG_HEADER - 2);
+    flash_log_buf[FLASH_LOG_HEADER - 2] = crc & 0xFF;
+    flash_log_buf[FLASH_LOG_HEADER - 1] = crc >> 8;
+    hal_flash_program(base, flash_log_buf, HAL_FLASH_PAGE_SIZE);
+
+    log->active = sector;
+    log->seq = seq;
+    log->write_pos = used;
+    log->next_erased = false;
+    log->rotations++;
+}
+
+// Anexa os tipos pendentes no fim do setor ativo, numa gravação só; os bytes
+// já gravados das páginas tocadas vão como 0xFF e não mudam
+static void flash_log_append(flash_log_t *log, uint32_t size) {
+    uint32_t start = log->write_pos & ~(HAL_FLASH_PAGE_SIZE - 1);
+    uint32_t skip = log->write_pos - start;
+    memset(flash_log_buf, 0xFF, sizeof(flash_log_buf));
+    flash_log_pack(log, log->dirty, flash_log_buf + skip);
+    hal_flash_program(flash_log_sector(log, log->active) + start, flash_log_buf, flash_log_pages(skip + size));
+    log->write_pos += size;
+}
+
+// Grava as versões pendentes e prepara o próximo setor. Para a XIP (gravar
+// uma página leva ~1 ms, apagar um setor ~45 ms): chamar só em pontos
+// seguros, com a tela parada. Cada commit faz uma coisa só, para as paradas
+// não se somarem: anexa, troca de setor (se o próximo já está apagado) ou
+// apaga o próximo. O que sobrar continua pendente; enquanto
+// flash_log_pending, chamar de novo (no máximo três commits seguidos).
+void flash_log_commit(flash_log_t *log) {
+    if (log->dirty) {
+        uint32_t size = flash_log_size(log, log->dirty);
+        uint32_t base = flash_log_sector(log, log->active);
+        bool fits = log->write_pos + size <= HAL_FLASH_SECTOR_SIZE && flash_log_blank(base + log->write_pos, size);
+        if (fits || log->next_erased) {
+            if (fits)
+                flash_log_append(log, size);
+            else
+                flash_log_rotate(log);
+            log->dirty = 0;
+            log->commits++;
+            return;
+        }
+    }
+    if (!log->next_erased) flash_log_erase_next(log);
+}
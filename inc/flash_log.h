@@ -0,0 +1,65 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal.h"
+
+// Registros persistentes (recordes, estatísticas, calibração) num log em
+// setores reservados da flash. Cada tipo de registro vale pela última versão
+// gravada; a cópia atual de todos os tipos fica em RAM, então ler nunca toca
+// a flash. As escritas só marcam o tipo como pendente: flash_log_commit, num
+// ponto seguro escolhido pelo firmware, anexa de uma vez as versões novas ao
+// fim do setor ativo (gravar só acrescenta, nunca reescreve).
+//
+// Setor cheio: o próximo setor do anel, já apagado antes, recebe um
+// cabeçalho com número de sequência maior e a versão atual de todos os
+// tipos; assim os setores se revezam (nivelamento de desgaste) e só o setor
+// ativo importa. Na partida basta ler os cabeçalhos para achar o ativo e
+// percorrer só os registros dele. Cabeçalhos e registros têm CRC-16: uma
+// gravação cortada por queda de energia é descartada e vale a versão
+// anterior. O cabeçalho de um setor novo é gravado por último.
+//
+// Layout de um setor:
+//   cabeçalho (16 bytes): "FLG1" | seq (u32) | 0xFF x 6 | CRC-16 (LE) dos 14 anteriores
+//   registros: tipo (u8) | tamanho n (u8) | CRC-16 (LE) de tipo, n e dados | n bytes,
+//              completados com 0xFF até múltiplo de 4; tipo 0xFF = espaço livre
+
+#define FLASH_LOG_MAGIC 0x31474C46u   // "FLG1"
+#define FLASH_LOG_HEADER 16
+#define FLASH_LOG_RECORD_HEADER 4
+#define FLASH_LOG_TYPES 8             // Tipos 0..7
+#define FLASH_LOG_MAX_PAYLOAD 60
+#define FLASH_LOG_MAX_SECTORS 16
+#define FLASH_LOG_EMPTY 0xFF
+
+// Todos os tipos juntos cabem no início de um setor novo
+_Static_assert(FLASH_LOG_HEADER + FLASH_LOG_TYPES * (FLASH_LOG_RECORD_HEADER + FLASH_LOG_MAX_PAYLOAD) <=
+                   HAL_FLASH_SECTOR_SIZE,
+               "tipos demais para um setor");
+
+typedef struct {
+  uint32_t offset;        // Início da região na flash (alinhado ao setor)
+  uint8_t sectors;        // Setores do anel (pelo menos 2)
+  uint8_t active;         // Setor ativo
+  uint32_t seq;           // Sequência do setor ativo
+  uint32_t write_pos;     // Próximo byte livre do setor ativo
+  bool next_erased;       // O próximo setor do anel já está apagado
+  uint8_t dirty;          // Bit por tipo com versão ainda não gravada
+  uint8_t valid;          // Bit por tipo com alguma versão
+  uint8_t len[FLASH_LOG_TYPES];
+  uint8_t data[FLASH_LOG_TYPES][FLASH_LOG_MAX_PAYLOAD];
+  // Estatísticas
+  uint32_t recovered;     // Registros válidos lidos na partida
+  uint32_t bad_records;   // Registros com CRC errado (gravação cortada)
+  uint32_t commits, rotations, erases;
+} flash_log_t;
+
+void flash_log_init(flash_log_t *log, uint32_t offset, uint8_t sectors);
+bool flash_log_get(const flash_log_t *log, uint8_t type, void *data, uint8_t len);
+bool flash_log_put(flash_log_t *log, uint8_t type, const void *data, uint8_t len);
+bool flash_log_pending(const flash_log_t *log);
+void flash_log_commit(flash_log_t *log);
+uint32_t flash_log_free(const flash_log_t *log);
+
+#endif
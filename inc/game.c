@@ -0,0 +1,117 @@
+#include "game.h"
+#include <stdlib.h>
+
+// xorshift32: só deslocamentos e XOR, barato no Cortex-M0+
+static uint32_t game_random(game_t *game) {
+    uint32_t x = game->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    game->rng = x;
+    return x;
+}
+
+// Nova posição aleatória do alvo, afastada 2 pixels das bordas
+static void game_place_target(game_t *game) {
+    game->target_x = (game_random(game) % (GAME_WIDTH - 4)) + 2;
+    game->target_y = (game_random(game) % (GAME_HEIGHT - 4)) + 2;
+}
+
+void game_init(game_t *game) {
+    game->cursor_x = GAME_WIDTH / 2;
+    game->cursor_y = GAME_HEIGHT / 2;
+    game->target_x = GAME_WIDTH / 2;
+    game->target_y = GAME_HEIGHT / 2;
+    game->score = 0;
+    game->click_count = 0;
+    game->playing = true;
+    game->paused = false;
+    game->game_over = false;
+    game->victory = false;
+    game->hit_count = 0;
+    game->reset_count = 0;
+    game->rng = 1;
+    game->rules.hit_radius = GAME_HIT_RADIUS;
+    game->rules.max_misses = GAME_MAX_MISSES;
+    game->rules.win_score = GAME_WIN_SCORE;
+}
+
+// O xorshift não sai do zero; a semente zero vira 1
+void game_seed(game_t *game, uint32_t seed) {
+    game->rng = seed ? seed : 1;
+}
+
+// Reinicia a partida
+void game_reset(game_t *game) {
+    game->score = 0;
+    game->click_count = 0;
+    game->game_over = false;
+    game->victory = false;
+    game->playing = true;
+    game->paused = false;
+    game->cursor_x = GAME_WIDTH / 2;
+    game->cursor_y = GAME_HEIGHT / 2;
+    game_place_target(game);
+    game->reset_count++;
+}
+
+void game_toggle_pause(game_t *game) {
+    game->paused = !game->paused;
+}
+
+// Indica se o cursor e os cliques estão sendo considerados
+bool game_accepts_input(const game_t *game) {
+    return !game->game_over && game->playing && !game->paused;
+}
+
+void game_set_cursor(game_t *game, uint8_t x, uint8_t y) {
+    game->cursor_x = x < GAME_WIDTH ? x : GAME_WIDTH - 1;
+    game->cursor_y = y < GAME_HEIGHT ? y : GAME_HEIGHT - 1;
+}
+
+// Substitui o alvo sorteado (replay de um trace gravado)
+void game_set_target(game_t *game, uint8_t x, uint8_t y) {
+    game->target_x = x;
+    game->target_y = y;
+}
+
+// Clique: testa acerto no alvo e as condições de fim de jogo.
+// Retorna true se a partida terminou neste clique.
+bool game_click(game_t *game) {
+    if (!game_accepts_input(game)) return false;
+
+    game->click_count++;
+    if (abs(game->cursor_x - game->target_x) < game->rules.hit_radius &&
+        abs(game->cursor_y - game->target_y) < game->rules.hit_radius) {
+        game->score++;
+        game->hit_count++;
+        game_place_target(game);
+        game->click_count = 0;
+    }
+
+    if (game->click_count > game->rules.max_misses) {
+        game->game_over = true;
+        game->victory = false;
+    }
+    if (game->score >= game->rules.win_score) {
+        game->game_over = true;
+        game->victory = true;
+    }
+    return game->game_over;
+}
+
+// Copia o estado do jogo para um snapshot imutável
+void game_snapshot(const game_t *game, game_snapshot_t *snap) {
+    snap->cursor_x = game->cursor_x;
+    snap->cursor_y = game->cursor_y;
+    snap->target_x = game->target_x;
+    snap->target_y = game->target_y;
+    snap->score = game->score;
+    snap->click_count = game->click_count;
+    snap->playing = game->playing;
+    snap->paused = game->paused;
+    snap->game_over = game->game_over;
+    snap->victory = game->victory;
+    snap->hits = game->hit_count;
+    snap->resets = game->reset_count;
+}
@@ -0,0 +1,49 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "game_snapshot.h"
+
+// Máquina de estados do jogo, sem dependência de hardware. O firmware aplica
+// entradas e agenda o reinício; o renderizador só vê snapshots. Todo o
+// estado, inclusive o gerador dos alvos e as regras, fica no game_t, então
+// várias partidas independentes podem rodar ao mesmo tempo (simulador).
+
+#define GAME_WIDTH 128
+#define GAME_HEIGHT 64
+// Regras padrão
+#define GAME_HIT_RADIUS 3        // Acerto quando |dx| e |dy| < raio
+#define GAME_MAX_MISSES 10       // Derrota com mais cliques que isso sem acertar
+#define GAME_WIN_SCORE 25
+#define GAME_RESET_DELAY_MS 5000 // Tempo da tela final antes de reiniciar
+
+typedef struct {
+  uint8_t hit_radius;
+  uint8_t max_misses;
+  uint8_t win_score;
+} game_rules_t;
+
+typedef struct {
+  uint8_t cursor_x, cursor_y;
+  uint8_t target_x, target_y;
+  uint8_t score;
+  uint8_t click_count;
+  bool playing, paused, game_over, victory;
+  uint32_t hit_count;    // Acertos acumulados desde o boot
+  uint32_t reset_count;  // Reinícios acumulados desde o boot
+  uint32_t rng;          // Estado do xorshift32 que sorteia os alvos
+  game_rules_t rules;
+} game_t;
+
+void game_init(game_t *game);
+void game_seed(game_t *game, uint32_t seed);
+void game_reset(game_t *game);
+void game_toggle_pause(game_t *game);
+bool game_accepts_input(const game_t *game);
+void game_set_cursor(game_t *game, uint8_t x, uint8_t y);
+void game_set_target(game_t *game, uint8_t x, uint8_t y);
+bool game_click(game_t *game);
+void game_snapshot(const game_t *game, game_snapshot_t *snap);
+
+#endif
@@ -0,0 +1,92 @@
+#include "game_render.h"
+#include "game.h"
+#include <string.h>
+
+// Marcador 3x3 centrado em (cx, cy), sem tocar a borda da tela
+static void game_render_marker(ssd1306_t *ssd, uint8_t cx, uint8_t cy) {
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            int x = cx + dx;
+            int y = cy + dy;
+            if (x >= 1 && x < SSD1306_WIDTH - 1 && y >= 1 && y < SSD1306_HEIGHT - 1) {
+                ssd1306_pixel(ssd, x, y, true);
+            }
+        }
+    }
+}
+
+// Tela de jogo: score, contagem de cliques, cursor e alvo
+void game_render_hud(ssd1306_t *ssd, const game_snapshot_t *snap) {
+    ssd1306_fill(ssd, false);
+
+    // Desenha score
+    ssd1306_draw_string(ssd, "Score:", 0, 0);
+    ssd1306_draw_uint(ssd, snap->score, 48, 0);
+
+    // Desenha contagem de cliques
+    ssd1306_draw_uint(ssd, snap->click_count, 0, 12);
+
+    game_render_marker(ssd, snap->cursor_x, snap->cursor_y);
+    game_render_marker(ssd, snap->target_x, snap->target_y);
+}
+
+// Telas de vitória/derrota
+void game_render_final(ssd1306_t *ssd, bool victory) {
+    ssd1306_fill(ssd, false);
+    if (victory) {
+        ssd1306_draw_string(ssd, "PARABENS!", 20, 20);
+        ssd1306_draw_string(ssd, "Score: 25", 30, 35);
+        ssd1306_draw_string(ssd, "VOCE COMPLETOU!", 5, 50);
+    } else {
+        ssd1306_draw_string(ssd, "GAME OVER!", 20, 20);
+        ssd1306_draw_string(ssd, "Voce perdeu!", 20, 35);
+    }
+}
+
+// Marcador 3x3, uma coluna por byte
+static const uint8_t game_marker_bitmap[3] = {0x07, 0x07, 0x07};
+
+void game_view_init(game_view_t *view) {
+    scene_init(&view->scene);
+    scene_add_label(&view->scene, 0, 0, "Score:");
+    view->score = scene_add_number(&view->scene, 48, 0, 0);
+    view->clicks = scene_add_number(&view->scene, 0, 12, 0);
+    view->cursor = scene_add_sprite(&view->scene, GAME_WIDTH / 2 - 1, GAME_HEIGHT / 2 - 1, 3, 3, game_marker_bitmap);
+    view->target = scene_add_sprite(&view->scene, GAME_WIDTH / 2 - 1, GAME_HEIGHT / 2 - 1, 3, 3, game_marker_bitmap);
+    view->final_shown = GAME_FINAL_NONE;
+    view->final_cached = 0;
+}
+
+// Copia a tela final para o framebuffer, desenhando-a só na primeira vez
+static void game_view_final(game_view_t *view, ssd1306_t *ssd, bool victory) {
+    game_final_t final = victory ? GAME_FINAL_VICTORY : GAME_FINAL_GAME_OVER;
+    if (view->final_shown == final) return;  // Já está no framebuffer
+
+    uint8_t *cache = view->final_cache[victory];
+    if (view->final_cached & (1u << victory)) {
+        memcpy(ssd->ram_buffer, cache, SSD1306_FB_SIZE);
+    } else {
+        game_render_final(ssd, victory);
+        memcpy(cache, ssd->ram_buffer, SSD1306_FB_SIZE);
+        view->final_cached |= 1u << victory;
+    }
+    view->final_shown = final;
+}
+
+// Desenha o quadro do snapshot: tela final inteira ou só o que mudou no HUD
+void game_view_render(game_view_t *view, ssd1306_t *ssd, const game_snapshot_t *snap) {
+    if (snap->game_over) {
+        game_view_final(view, ssd, snap->victory);
+        return;
+    }
+    if (view->final_shown != GAME_FINAL_NONE) {
+        scene_invalidate(&view->scene);
+        view->final_shown = GAME_FINAL_NONE;
+    }
+
+    scene_set_number(&view->scene, view->score, snap->score);
+    scene_set_number(&view->scene, view->clicks, snap->click_count);
+    scene_move(&view->scene, view->cursor, snap->cursor_x - 1, snap->cursor_y - 1);
+    scene_move(&view->scene, view->target, snap->target_x - 1, snap->target_y - 1);
+    scene_render(&view->scene, ssd);
+}
@@ -0,0 +1,33 @@
+#ifndef GAME_RENDER_H
+#define GAME_RENDER_H
+
+#include "ssd1306.h"
+#include "game_snapshot.h"
+#include "scene.h"
+
+// Desenho das telas do jogo no framebuffer (sem enviar ao display).
+// game_render_hud redesenha tudo; game_view mantém o HUD como cena retida e
+// só redesenha o que mudou desde o último quadro. As telas finais são
+// desenhadas uma vez, guardadas e depois só copiadas para o framebuffer.
+
+typedef enum {
+  GAME_FINAL_NONE,
+  GAME_FINAL_GAME_OVER,
+  GAME_FINAL_VICTORY
+} game_final_t;
+
+typedef struct {
+  scene_t scene;
+  int score, clicks, cursor, target;  // Objetos da cena
+  game_final_t final_shown;           // Tela final ocupando o framebuffer
+  uint8_t final_cached;               // Bit por tela final já desenhada
+  uint8_t final_cache[2][SSD1306_FB_SIZE];
+} game_view_t;
+
+void game_render_hud(ssd1306_t *ssd, const game_snapshot_t *snap);
+void game_render_final(ssd1306_t *ssd, bool victory);
+
+void game_view_init(game_view_t *view);
+void game_view_render(game_view_t *view, ssd1306_t *ssd, const game_snapshot_t *snap);
+
+#endif
@@ -0,0 +1,59 @@
+#include "game_snapshot.h"
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+static game_snapshot_t slot;
+static volatile uint32_t seq = 0;            // Ímpar durante a escrita
+static volatile uint32_t merged_on_push = 0;  // FIFO cheio (escrito pelo core0)
+static volatile uint32_t merged_on_pop = 0;   // Avisos acumulados (escrito pelo core1)
+
+// Core0: grava o snapshot sem nunca bloquear
+void game_snapshot_publish(const game_snapshot_t *snap) {
+    uint32_t s = seq + 1;
+    seq = s;
+    __dmb();
+    slot = *snap;
+    __dmb();
+    seq = s + 1;
+
+    if (multicore_fifo_wready())
+        multicore_fifo_push_blocking(s + 1);
+    else
+        merged_on_push++;
+}
+
+// Lê o snapshot mais recente, repetindo se o core0 escreveu no meio da cópia
+void game_snapshot_read(game_snapshot_t *snap) {
+    uint32_t before, after;
+    do {
+        do {
+            before = seq;
+        } while (before & 1);
+        __dmb();
+        *snap = slot;
+        __dmb();
+        after = seq;
+    } while (before != after);
+}
+
+// Core1: espera um aviso no FIFO; avisos extras já enfileirados são
+// snapshots que o renderizador não chegou a desenhar
+void game_snapshot_wait(game_snapshot_t *snap) {
+    multicore_fifo_pop_blocking();
+    while (multicore_fifo_rvalid()) {
+        multicore_fifo_pop_blocking();
+        merged_on_pop++;
+    }
+    game_snapshot_read(snap);
+}
+
+// Core1, sem bloquear: retorna false se não há snapshot novo
+bool game_snapshot_poll(game_snapshot_t *snap) {
+    if (!multicore_fifo_rvalid()) return false;
+    game_snapshot_wait(snap);
+    return true;
+}
+
+uint32_t game_snapshot_merged(void) {
+    return merged_on_push + merged_on_pop;
+}
@@ -0,0 +1,36 @@
+#ifndef GAME_SNAPSHOT_H
+#define GAME_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Cópia imutável do estado do jogo entregue ao renderizador.
+// O core0 publica com um seqlock; o core1 é acordado pelo FIFO entre cores
+// e sempre lê o snapshot mais recente, mesclando os que perdeu.
+
+typedef struct {
+  uint8_t cursor_x, cursor_y;
+  uint8_t target_x, target_y;
+  uint8_t score, click_count;
+  bool playing, paused, game_over, victory;
+  uint32_t hits;    // Acertos acumulados (dispara som e matriz de LEDs)
+  uint32_t resets;  // Reinícios acumulados
+} game_snapshot_t;
+
+void game_snapshot_publish(const game_snapshot_t *snap);
+void game_snapshot_read(game_snapshot_t *snap);
+void game_snapshot_wait(game_snapshot_t *snap);
+bool game_snapshot_poll(game_snapshot_t *snap);
+uint32_t game_snapshot_merged(void);
+
+// Comparação campo a campo (o preenchimento da struct não é inicializado)
+static inline bool game_snapshot_equal(const game_snapshot_t *a, const game_snapshot_t *b) {
+  return a->cursor_x == b->cursor_x && a->cursor_y == b->cursor_y &&
+         a->target_x == b->target_x && a->target_y == b->target_y &&
+         a->score == b->score && a->click_count == b->click_count &&
+         a->playing == b->playing && a->paused == b->paused &&
+         a->game_over == b->game_over && a->victory == b->victory &&
+         a->hits == b->hits && a->resets == b->resets;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef HAL_H
+#define HAL_H
+
+// Camada fina de abstração de hardware. No firmware as funções repassam ao
+// Pico SDK (hal_pico.c); no build nativo (HAL_HOST) são simuladas e
+// registradas em memória (host/hal_host.c).
+
+#ifdef HAL_HOST
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+typedef unsigned int uint;
+typedef struct i2c_inst i2c_inst_t;
+static inline void tight_loop_contents(void) {}
+#else
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#endif
+
+// Bits das palavras de um fluxo I2C (mesmo formato do registrador IC_DATA_CMD)
+#define HAL_I2C_STOP (1u << 9)
+#define HAL_I2C_RESTART (1u << 10)
+
+typedef void (*hal_callback_t)(void *user_data);
+
+// I2C: escrita bloqueante e fluxo de palavras enviado em segundo plano
+int hal_i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int hal_i2c_stream_init(i2c_inst_t *i2c);
+void hal_i2c_stream_set_callback(int stream, hal_callback_t callback, void *user_data);
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count);
+bool hal_i2c_stream_busy(int stream, i2c_inst_t *i2c);
+bool hal_i2c_take_abort(i2c_inst_t *i2c);
+
+// PWM (divisor em 1/16)
+void hal_pwm_configure(uint gpio, uint32_t div16, uint32_t wrap);
+void hal_pwm_set_level(uint gpio, uint16_t level);
+void hal_pwm_set_enabled(uint gpio, bool enabled);
+
+// GPIO
+void hal_gpio_put(uint gpio, bool value);
+
+// Flash: offsets a partir do início da flash. Apagar (setor inteiro) e
+// gravar (páginas inteiras; só leva bits de 1 para 0) param a execução a
+// partir da flash nos dois cores enquanto duram: o outro core fica
+// estacionado em RAM, se tiver se registrado, e as interrupções desligadas.
+#define HAL_FLASH_SECTOR_SIZE 4096u
+#define HAL_FLASH_PAGE_SIZE 256u
+const uint8_t *hal_flash_read(uint32_t offset);
+void hal_flash_erase(uint32_t offset, uint32_t len);
+void hal_flash_program(uint32_t offset, const uint8_t *data, uint32_t len);
+// Outro core: habilita o estacionamento e oferece pontos seguros para ele
+void hal_flash_park_enable(void);
+void hal_flash_park_point(void);
+
+#endif
@@ -0,0 +1,150 @@
+#include "hal.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+#define MAX_STREAMS 12  // Um por canal de DMA
+
+static hal_callback_t stream_callbacks[MAX_STREAMS];
+static void *stream_user_data[MAX_STREAMS];
+static bool irq_installed = false;
+
+static void hal_stream_irq_handler(void) {
+    for (int chan = 0; chan < MAX_STREAMS; ++chan) {
+        if (!stream_callbacks[chan] || !dma_channel_get_irq0_status(chan)) continue;
+        dma_channel_acknowledge_irq0(chan);
+        stream_callbacks[chan](stream_user_data[chan]);
+    }
+}
+
+int hal_i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    return i2c_write_blocking(i2c, addr, src, len, nostop);
+}
+
+// Canal de DMA de 16 bits alimentando o FIFO de TX do I2C (IC_DATA_CMD)
+int hal_i2c_stream_init(i2c_inst_t *i2c) {
+    int chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(chan, &c, &i2c_get_hw(i2c)->data_cmd, NULL, 0, false);
+    return chan;
+}
+
+// O callback roda na IRQ de DMA quando a última palavra entra no FIFO
+void hal_i2c_stream_set_callback(int stream, hal_callback_t callback, void *user_data) {
+    stream_user_data[stream] = user_data;
+    stream_callbacks[stream] = callback;
+    dma_channel_set_irq0_enabled(stream, callback != NULL);
+    if (callback && !irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, hal_stream_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irq_installed = true;
+    }
+}
+
+void hal_i2c_stream_start(int stream, i2c_inst_t *i2c, uint8_t addr, const uint16_t *words, size_t count) {
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    dma_channel_transfer_from_buffer_now(stream, words, count);
+}
+
+// Ocupado enquanto o DMA envia ou o FIFO do I2C ainda esvazia
+bool hal_i2c_stream_busy(int stream, i2c_inst_t *i2c) {
+    if (dma_channel_is_busy(stream)) return true;
+    uint32_t status = i2c_get_hw(i2c)->status;
+    return !(status & I2C_IC_STATUS_TFE_BITS) || (status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Retorna true (e limpa o sinal) se a última transferência terminou em NACK
+bool hal_i2c_take_abort(i2c_inst_t *i2c) {
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    if (!(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)) return false;
+    (void)hw->clr_tx_abrt;
+    return true;
+}
+
+void hal_pwm_configure(uint gpio, uint32_t div16, uint32_t wrap) {
+    uint slice = pwm_gpio_to_slice_num(gpio);
+    pwm_set_clkdiv_int_frac(slice, div16 >> 4, div16 & 0xF);
+    pwm_set_wrap(slice, wrap);
+}
+
+void hal_pwm_set_level(uint gpio, uint16_t level) {
+    pwm_set_gpio_level(gpio, level);
+}
+
+void hal_pwm_set_enabled(uint gpio, bool enabled) {
+    pwm_set_enabled(pwm_gpio_to_slice_num(gpio), enabled);
+}
+
+void hal_gpio_put(uint gpio, bool value) {
+    gpio_put(gpio, value);
+}
+
+// Estacionamento do outro core durante apagar/gravar. Não usa o FIFO entre
+// cores (ocupado pelos avisos de snapshot): o core0 pede por uma variável e
+// acorda o outro com SEV; o outro, no próximo ponto seguro, confirma e gira
+// em RAM com as interrupções desligadas até ser liberado.
+static volatile bool park_enabled = false;
+static volatile bool park_request = false;
+static volatile bool parked = false;
+
+void hal_flash_park_enable(void) {
+    park_enabled = true;
+}
+
+static void __not_in_flash_func(hal_flash_parked)(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    parked = true;
+    while (park_request)
+        __compiler_memory_barrier();
+    parked = false;
+    restore_interrupts(irq);
+}
+
+void hal_flash_park_point(void) {
+    if (park_request)
+        hal_flash_parked();
+}
+
+static uint32_t hal_flash_begin(void) {
+    if (park_enabled) {
+        park_request = true;
+        __sev();
+        while (!parked)
+            tight_loop_contents();
+    }
+    return save_and_disable_interrupts();
+}
+
+static void hal_flash_end(uint32_t irq) {
+    restore_interrupts(irq);
+    if (park_enabled) {
+        park_request = false;
+        while (parked)
+            tight_loop_contents();
+    }
+}
+
+const uint8_t *hal_flash_read(uint32_t offset) {
+    return (const uint8_t *)(XIP_BASE + offset);
+}
+
+void hal_flash_erase(uint32_t offset, uint32_t len) {
+    uint32_t irq = hal_flash_begin();
+    flash_range_erase(offset, len);
+    hal_flash_end(irq);
+}
+
+void hal_flash_program(uint32_t offset, const uint8_t *data, uint32_t len) {
+    uint32_t irq = hal_flash_begin();
+    flash_range_program(offset, data, len);
+    hal_flash_end(irq);
+}
@@ -0,0 +1,116 @@
+#include "input_trace.h"
+#include <stdio.h>
+
+#define TRACE_MAX_RECORD 16  // Tipo + 3 varints de até 5 bytes
+
+static size_t trace_put_varint(uint8_t *dst, uint32_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        dst[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    dst[n++] = (uint8_t)value;
+    return n;
+}
+
+static bool trace_get_varint(input_trace_reader_t *reader, uint32_t *value) {
+    uint32_t result = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        if (reader->pos >= reader->len) return false;
+        uint8_t byte = reader->buf[reader->pos++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+void input_trace_init(input_trace_t *trace, uint8_t *buf, size_t cap) {
+    trace->buf = buf;
+    trace->cap = cap;
+    input_trace_start(trace, 0);
+}
+
+void input_trace_start(input_trace_t *trace, uint32_t now_us) {
+    trace->len = 0;
+    trace->start_us = now_us;
+    trace->last_us = now_us;
+    trace->records = 0;
+    trace->full = false;
+}
+
+// Grava um registro com até dois campos; o tempo vira delta do anterior
+static bool trace_append(input_trace_t *trace, trace_type_t type, uint32_t now_us,
+                         uint8_t fields, uint32_t a, uint32_t b) {
+    if (trace->full || trace->cap - trace->len < TRACE_MAX_RECORD) {
+        trace->full = true;
+        return false;
+    }
+    uint8_t *dst = trace->buf + trace->len;
+    size_t n = 0;
+    dst[n++] = type;
+    n += trace_put_varint(dst + n, now_us - trace->last_us);
+    if (fields > 0) n += trace_put_varint(dst + n, a);
+    if (fields > 1) n += trace_put_varint(dst + n, b);
+    trace->len += n;
+    trace->last_us = now_us;
+    trace->records++;
+    return true;
+}
+
+bool input_trace_event(input_trace_t *trace, trace_type_t type, uint32_t now_us) {
+    return trace_append(trace, type, now_us, 0, 0, 0);
+}
+
+bool input_trace_target(input_trace_t *trace, uint32_t now_us, uint8_t x, uint8_t y) {
+    return trace_append(trace, TRACE_TARGET, now_us, 2, x, y);
+}
+
+bool input_trace_cursor(input_trace_t *trace, uint32_t now_us, uint8_t x, uint8_t y) {
+    return trace_append(trace, TRACE_CURSOR, now_us, 2, x, y);
+}
+
+// Despejo em texto, seguro para o terminal USB: cabeçalho com o tamanho,
+// linhas hexadecimais de 32 bytes e um marcador de fim
+void input_trace_dump_hex(const input_trace_t *trace) {
+    printf("%s %lu %lu%s\n", INPUT_TRACE_MAGIC, (unsigned long)trace->len,
+           (unsigned long)trace->records, trace->full ? " cheio" : "");
+    for (size_t i = 0; i < trace->len; ++i) {
+        printf("%02x", trace->buf[i]);
+        if ((i & 31) == 31 || i + 1 == trace->len) printf("\n");
+    }
+    printf("END\n");
+}
+
+void input_trace_reader_init(input_trace_reader_t *reader, const uint8_t *buf, size_t len) {
+    reader->buf = buf;
+    reader->len = len;
+    reader->pos = 0;
+    reader->time_us = 0;
+}
+
+// Decodifica o próximo registro; false no fim do trace ou se ele estiver truncado
+bool input_trace_next(input_trace_reader_t *reader, trace_record_t *record) {
+    if (reader->pos >= reader->len) return false;
+
+    uint8_t type = reader->buf[reader->pos++];
+    uint32_t dt, a = 0, b = 0;
+    if (type < TRACE_BUTTON_A || type >= TRACE_TYPES) return false;
+    if (!trace_get_varint(reader, &dt)) return false;
+    if (type == TRACE_TARGET || type == TRACE_CURSOR) {
+        if (!trace_get_varint(reader, &a) || !trace_get_varint(reader, &b)) return false;
+    }
+
+    reader->time_us += dt;
+    record->type = type;
+    record->time_us = reader->time_us;
+    record->x = 0;
+    record->y = 0;
+    if (type == TRACE_TARGET || type == TRACE_CURSOR) {
+        record->x = a;
+        record->y = b;
+    }
+    return true;
+}
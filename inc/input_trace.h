@@ -0,0 +1,61 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Gravação compacta das entradas de uma sessão para replay determinístico.
+// Cada registro é: byte de tipo, delta de tempo (varint, µs) e a carga do
+// tipo. O joystick entra no trace depois do filtro e da calibração: o cursor
+// guarda a posição na tela sempre que ela muda. O filtro tem estado, então
+// repeti-lo exigiria a leitura bruta de todo tick de 1 ms, que encheria o
+// buffer em segundos. O alvo guarda a posição sorteada, para o replay não
+// depender de rand(). O buffer é linear e para de gravar quando enche: o
+// replay precisa do estado inicial, que um anel sobrescreveria.
+// Não depende do SDK.
+
+#define INPUT_TRACE_MAGIC "JTR1"
+
+typedef enum {
+  TRACE_BUTTON_A = 2,  // Pausa / retoma (1 era a leitura bruta do joystick)
+  TRACE_BUTTON_B,      // Reinício pelo botão
+  TRACE_CLICK,         // Clique do joystick
+  TRACE_CLAP,          // Palma detectada (conta como clique)
+  TRACE_RESET,         // Reinício após a tela final
+  TRACE_TARGET,        // x, y: novo alvo
+  TRACE_CURSOR,        // x, y: posição do cursor na tela
+  TRACE_TYPES
+} trace_type_t;
+
+typedef struct {
+  uint8_t type;
+  uint32_t time_us;  // Desde o início da gravação
+  uint16_t x, y;
+} trace_record_t;
+
+typedef struct {
+  uint8_t *buf;
+  size_t cap, len;
+  uint32_t start_us, last_us;
+  uint32_t records;
+  bool full;                // Algum registro não coube
+} input_trace_t;
+
+typedef struct {
+  const uint8_t *buf;
+  size_t len, pos;
+  uint32_t time_us;
+} input_trace_reader_t;
+
+void input_trace_init(input_trace_t *trace, uint8_t *buf, size_t cap);
+void input_trace_start(input_trace_t *trace, uint32_t now_us);
+bool input_trace_event(input_trace_t *trace, trace_type_t type, uint32_t now_us);
+bool input_trace_target(input_trace_t *trace, uint32_t now_us, uint8_t x, uint8_t y);
+bool input_trace_cursor(input_trace_t *trace, uint32_t now_us, uint8_t x, uint8_t y);
+void input_trace_dump_hex(const input_trace_t *trace);
+
+void input_trace_reader_init(input_trace_reader_t *reader, const uint8_t *buf, size_t len);
+bool input_trace_next(input_trace_reader_t *reader, trace_record_t *record);
+
+#endif
@@ -0,0 +1,166 @@
+#include "joystick.h"
+#include <string.h>
+
+const joystick_config_t joystick_default_config = {
+    .dead_zone = 123,   // 3% do curso
+    .curve = 0,
+    .filter_shift = 3,  // Constante de tempo de ~8 amostras (8 ms a 1 kHz)
+};
+
+// Coordenada de tela para uma leitura do ADC, só na montagem das tabelas
+static uint8_t joystick_map(const joystick_t *js, int axis, uint32_t raw) {
+    const joystick_axis_cal_t *cal = &js->cal[axis];
+    int32_t span = raw >= cal->center ? cal->max - cal->center : cal->center - cal->min;
+    int32_t dist = raw >= cal->center ? (int32_t)raw - cal->center : cal->center - (int32_t)raw;
+
+    // Deslocamento normalizado do centro, em Q12
+    int32_t u = span > 0 ? (int32_t)(((int64_t)dist * JOYSTICK_ONE) / span) : 0;
+    if (u > JOYSTICK_ONE) u = JOYSTICK_ONE;
+
+    int32_t dz = js->config.dead_zone;
+    u = u <= dz ? 0 : (int32_t)(((int64_t)(u - dz) * JOYSTICK_ONE) / (JOYSTICK_ONE - dz));
+
+    int32_t cube = (int32_t)(((int64_t)u * u / JOYSTICK_ONE) * u / JOYSTICK_ONE);
+    u = (int32_t)(((int64_t)u * (JOYSTICK_ONE - js->config.curve) + (int64_t)cube * js->config.curve) / JOYSTICK_ONE);
+
+    // [-1, 1] para [0, size - 1], arredondado
+    int32_t v = raw >= cal->center ? u : -u;
+    int32_t pos = ((v + JOYSTICK_ONE) * (js->size[axis] - 1) + JOYSTICK_ONE) / (2 * JOYSTICK_ONE);
+    return js->invert[axis] ? js->size[axis] - 1 - pos : pos;
+}
+
+// Cada entrada cobre 2^(12 - LUT_BITS) contagens; vale o meio do intervalo
+static void joystick_build_luts(joystick_t *js) {
+    const uint32_t step = 1u << (JOYSTICK_ADC_BITS - JOYSTICK_LUT_BITS);
+    for (int axis = 0; axis < 2; ++axis) {
+        for (uint32_t i = 0; i < JOYSTICK_LUT_SIZE; ++i)
+            js->lut[axis][i] = joystick_map(js, axis, i * step + step / 2);
+    }
+}
+
+// Zona morta de 100% dividiria por zero em joystick_map e uma curva acima de
+// 1,0 daria peso negativo à parte linear: ambas são limitadas
+static void joystick_set_config(joystick_t *js, const joystick_config_t *config) {
+    js->config = *config;
+    if (js->config.dead_zone >= JOYSTICK_ONE) js->config.dead_zone = JOYSTICK_ONE - 1;
+    if (js->config.curve > JOYSTICK_ONE) js->config.curve = JOYSTICK_ONE;
+}
+
+void joystick_init(joystick_t *js, const joystick_config_t *config, uint8_t width, uint8_t height, bool invert_y) {
+    memset(js, 0, sizeof(*js));
+    joystick_set_config(js, config);
+    js->size[0] = width;
+    js->size[1] = height;
+    js->invert[1] = invert_y;
+    for (int axis = 0; axis < 2; ++axis)
+        js->cal[axis] = (joystick_axis_cal_t){0, JOYSTICK_ADC_MAX / 2, JOYSTICK_ADC_MAX};
+    js->x = width / 2;
+    js->y = height / 2;
+    joystick_build_luts(js);
+}
+
+void joystick_configure(joystick_t *js, const joystick_config_t *config) {
+    joystick_set_config(js, config);
+    joystick_build_luts(js);
+}
+
+// Centro medido com o joystick solto (normalmente na partida)
+void joystick_set_center(joystick_t *js, uint16_t raw_x, uint16_t raw_y) {
+    js->cal[0].center = raw_x;
+    js->cal[1].center = raw_y;
+    joystick_build_luts(js);
+}
+
+// Calibração dos extremos: enquanto ativa, joystick_update registra as
+// leituras mínima e máxima de cada eixo; o usuário gira o joystick até o fim
+// do curso em todas as direções e a calibração é encerrada
+void joystick_calibration_begin(joystick_t *js) {
+    for (int axis = 0; axis < 2; ++axis) {
+        uint16_t c = js->cal[axis].center;
+        js->sweep[axis] = (joystick_axis_cal_t){c, c, c};
+    }
+    js->calibrating = true;
+}
+
+// Aplica os extremos vistos; retorna false (mantendo a calibração anterior)
+// se algum lado de algum eixo não foi percorrido o suficiente
+bool joystick_calibration_end(joystick_t *js) {
+    js->calibrating = false;
+    for (int axis = 0; axis < 2; ++axis) {
+        const joystick_axis_cal_t *s = &js->sweep[axis];
+        if (s->center - s->min < JOYSTICK_MIN_SPAN || s->max - s->center < JOYSTICK_MIN_SPAN)
+            return false;
+    }
+    for (int axis = 0; axis < 2; ++axis) {
+        js->cal[axis].min = js->sweep[axis].min;
+        js->cal[axis].max = js->sweep[axis].max;
+    }
+    joystick_build_luts(js);
+    return true;
+}
+
+// Extremos de uma calibração anterior (gravada na flash); o centro continua
+// o medido. Recusa extremos que deixariam um lado curto demais.
+bool joystick_set_extents(joystick_t *js, const joystick_axis_cal_t cal[2]) {
+    for (int axis = 0; axis < 2; ++axis) {
+        uint16_t c = js->cal[axis].center;
+        if (c < cal[axis].min || c - cal[axis].min < JOYSTICK_MIN_SPAN ||
+            c > cal[axis].max || cal[axis].max - c < JOYSTICK_MIN_SPAN)
+            return false;
+    }
+    for (int axis = 0; axis < 2; ++axis) {
+        js->cal[axis].min = cal[axis].min;
+        js->cal[axis].max = cal[axis].max;
+    }
+    joystick_build_luts(js);
+    return true;
+}
+
+// IIR de primeira ordem em Q4: y += (x - y) / 2^shift
+static inline uint16_t joystick_filter(uint16_t state, uint16_t raw, uint8_t shift) {
+    int32_t target = (int32_t)raw << JOYSTICK_FILTER_FRAC;
+    return (uint16_t)(state + ((target - (int32_t)state) >> shift));
+}
+
+// Histerese: o cursor só deixa a posição atual quando as entradas vizinhas
+// da tabela também apontam para fora dela, ou seja, com a leitura filtrada
+// a pelo menos JOYSTICK_HYSTERESIS entradas da fronteira
+static inline uint8_t joystick_lookup(const uint8_t *lut, uint16_t filter, uint8_t current) {
+    int32_t i = filter >> (JOYSTICK_FILTER_FRAC + JOYSTICK_ADC_BITS - JOYSTICK_LUT_BITS);
+    uint8_t pos = lut[i];
+    if (pos == current) return pos;
+    int32_t lo = i - JOYSTICK_HYSTERESIS, hi = i + JOYSTICK_HYSTERESIS;
+    if (lo < 0) lo = 0;
+    if (hi > (int32_t)JOYSTICK_LUT_SIZE - 1) hi = JOYSTICK_LUT_SIZE - 1;
+    return lut[lo] == current || lut[hi] == current ? current : pos;
+}
+
+// Uma amostra de cada eixo; retorna true se a posição na tela mudou
+bool joystick_update(joystick_t *js, uint16_t raw_x, uint16_t raw_y) {
+    if (raw_x > JOYSTICK_ADC_MAX) raw_x = JOYSTICK_ADC_MAX;
+    if (raw_y > JOYSTICK_ADC_MAX) raw_y = JOYSTICK_ADC_MAX;
+
+    if (js->calibrating) {
+        uint16_t raw[2] = {raw_x, raw_y};
+        for (int axis = 0; axis < 2; ++axis) {
+            if (raw[axis] < js->sweep[axis].min) js->sweep[axis].min = raw[axis];
+            if (raw[axis] > js->sweep[axis].max) js->sweep[axis].max = raw[axis];
+        }
+    }
+
+    if (!js->primed) {
+        js->filter[0] = raw_x << JOYSTICK_FILTER_FRAC;
+        js->filter[1] = raw_y << JOYSTICK_FILTER_FRAC;
+        js->primed = true;
+    } else {
+        js->filter[0] = joystick_filter(js->filter[0], raw_x, js->config.filter_shift);
+        js->filter[1] = joystick_filter(js->filter[1], raw_y, js->config.filter_shift);
+    }
+
+    uint8_t x = joystick_lookup(js->lut[0], js->filter[0], js->x);
+    uint8_t y = joystick_lookup(js->lut[1], js->filter[1], js->y);
+    bool moved = x != js->x || y != js->y;
+    js->x = x;
+    js->y = y;
+    return moved;
+}
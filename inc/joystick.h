@@ -0,0 +1,58 @@
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Joystick analógico calibrado, em ponto fixo. Cada eixo passa por um filtro
+// IIR de primeira ordem (só soma e deslocamento) e por uma tabela que leva a
+// leitura filtrada direto à coordenada da tela, já com calibração (centro e
+// extremos de cada lado), zona morta e curva de resposta; uma histerese
+// pequena segura o cursor na fronteira entre dois pixels. As tabelas são
+// refeitas só quando a calibração ou a configuração mudam; por amostra o
+// custo é um filtro e uma consulta por eixo.
+// Não depende do SDK.
+
+#define JOYSTICK_ADC_BITS 12
+#define JOYSTICK_ADC_MAX ((1u << JOYSTICK_ADC_BITS) - 1)
+#define JOYSTICK_LUT_BITS 10         // Entradas por eixo: 4 contagens do ADC cada
+#define JOYSTICK_LUT_SIZE (1u << JOYSTICK_LUT_BITS)
+#define JOYSTICK_FILTER_FRAC 4       // Bits fracionários do estado do filtro
+#define JOYSTICK_HYSTERESIS 1        // Entradas da tabela de folga antes de trocar de pixel
+#define JOYSTICK_ONE 4096            // 1,0 em Q12 (zona morta e curva)
+#define JOYSTICK_MIN_SPAN 512        // Menor curso aceito de cada lado na calibração
+
+typedef struct {
+  uint16_t dead_zone;    // Fração do curso ignorada em volta do centro (Q12, até 4095)
+  uint16_t curve;        // Mistura da resposta cúbica (Q12): 0 linear, 4096 cúbica (máximo)
+  uint8_t filter_shift;  // Peso da amostra nova no IIR: 2^-shift (0 = sem filtro)
+} joystick_config_t;
+
+typedef struct {
+  uint16_t min, center, max;  // Leituras do ADC
+} joystick_axis_cal_t;
+
+typedef struct {
+  joystick_config_t config;
+  joystick_axis_cal_t cal[2];         // X, Y
+  uint8_t size[2];                    // Pixels de cada eixo
+  bool invert[2];                     // Eixo cresce no sentido oposto ao da tela
+  uint8_t lut[2][JOYSTICK_LUT_SIZE];
+  uint16_t filter[2];                 // Estado do IIR, Q4
+  bool primed;                        // Filtro já recebeu a primeira amostra
+  bool calibrating;
+  joystick_axis_cal_t sweep[2];       // Extremos vistos durante a calibração
+  uint8_t x, y;                       // Posição atual na tela
+} joystick_t;
+
+extern const joystick_config_t joystick_default_config;
+
+void joystick_init(joystick_t *js, const joystick_config_t *config, uint8_t width, uint8_t height, bool invert_y);
+void joystick_configure(joystick_t *js, const joystick_config_t *config);
+void joystick_set_center(joystick_t *js, uint16_t raw_x, uint16_t raw_y);
+void joystick_calibration_begin(joystick_t *js);
+bool joystick_calibration_end(joystick_t *js);
+bool joystick_set_extents(joystick_t *js, const joystick_axis_cal_t cal[2]);
+bool joystick_update(joystick_t *js, uint16_t raw_x, uint16_t raw_y);
+
+#endif
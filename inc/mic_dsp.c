@@ -0,0 +1,88 @@
+#include "mic_dsp.h"
+
+// Raiz quadrada inteira (método dígito a dígito, sem divisões)
+static uint32_t isqrt32(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void mic_dsp_init(mic_dsp_t *dsp) {
+    dsp->dc = 0;
+    dsp->envelope = 0;
+    dsp->noise_floor = 4096u << MIC_DSP_FRAC_BITS;  // Desce até o ruído real
+    dsp->peak = 0;
+    dsp->refractory = 0;
+    dsp->primed = false;
+}
+
+uint32_t mic_dsp_block_mean(const uint16_t *samples, uint32_t n) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < n; ++i)
+        sum += samples[i];
+    return sum / n;
+}
+
+// RMS do bloco após remover o DC (dc em Q4). Amostras de 12 bits dão
+// quadrados de até 2^24, então blocos de até 256 amostras cabem em 32 bits.
+uint32_t mic_dsp_block_rms(const uint16_t *samples, uint32_t n, int32_t dc, uint16_t *peak) {
+    int32_t offset = dc >> MIC_DSP_FRAC_BITS;
+    uint32_t sum_sq = 0;
+    uint16_t max_abs = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        int32_t x = (int32_t)samples[i] - offset;
+        uint32_t a = x < 0 ? -x : x;
+        if (a > max_abs) max_abs = a;
+        sum_sq += a * a;
+    }
+    *peak = max_abs;
+    return isqrt32(sum_sq / n);
+}
+
+// Processa um bloco e retorna true se um ataque foi detectado nele
+bool mic_dsp_process_block(mic_dsp_t *dsp, const uint16_t *samples, uint32_t n) {
+    if (n == 0) return false;
+
+    // DC: média do bloco suavizada entre blocos
+    int32_t mean = (int32_t)mic_dsp_block_mean(samples, n) << MIC_DSP_FRAC_BITS;
+    if (!dsp->primed) {
+        dsp->dc = mean;
+        dsp->primed = true;
+    } else {
+        dsp->dc += (mean - dsp->dc) >> 3;
+    }
+
+    // Envelope: ataque rápido, liberação lenta
+    uint32_t rms = mic_dsp_block_rms(samples, n, dsp->dc, &dsp->peak) << MIC_DSP_FRAC_BITS;
+    if (rms > dsp->envelope)
+        dsp->envelope += (rms - dsp->envelope) >> 1;
+    else
+        dsp->envelope -= (dsp->envelope - rms) >> 3;
+
+    bool onset = false;
+    if (dsp->refractory > 0) {
+        dsp->refractory--;
+    } else if (dsp->envelope > (dsp->noise_floor << MIC_DSP_ONSET_RATIO_SHIFT) &&
+               dsp->envelope > (MIC_DSP_MIN_LEVEL << MIC_DSP_FRAC_BITS)) {
+        onset = true;
+        dsp->refractory = MIC_DSP_REFRACTORY_BLOCKS;
+    }
+
+    // Piso de ruído: desce rápido, sobe devagar e não acompanha ataques
+    if (dsp->envelope < dsp->noise_floor)
+        dsp->noise_floor -= (dsp->noise_floor - dsp->envelope) >> 2;
+    else if (dsp->refractory == 0)
+        dsp->noise_floor += (dsp->envelope - dsp->noise_floor) >> 6;
+
+    return onset;
+}
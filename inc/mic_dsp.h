@@ -0,0 +1,32 @@
+#ifndef MIC_DSP_H
+#define MIC_DSP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Front-end de áudio do microfone em ponto fixo, processado em blocos:
+// remoção de DC, envelope RMS/pico, piso de ruído adaptativo e detecção de
+// ataque (palma) com janela refratária. Não depende do SDK, então os mesmos
+// kernels podem ser compilados no host.
+
+#define MIC_DSP_BLOCK 64            // Amostras por bloco
+#define MIC_DSP_FRAC_BITS 4         // Envelope e piso em Q4
+#define MIC_DSP_ONSET_RATIO_SHIFT 2 // Ataque quando envelope > 4x piso
+#define MIC_DSP_MIN_LEVEL 120       // Nível RMS mínimo (contagens do ADC)
+#define MIC_DSP_REFRACTORY_BLOCKS 24
+
+typedef struct {
+  int32_t dc;          // Nível DC em Q4
+  uint32_t envelope;   // Q4
+  uint32_t noise_floor;// Q4
+  uint16_t peak;       // Pico do último bloco (sem DC)
+  uint16_t refractory; // Blocos restantes sem novo ataque
+  bool primed;         // DC inicializado pelo primeiro bloco
+} mic_dsp_t;
+
+void mic_dsp_init(mic_dsp_t *dsp);
+uint32_t mic_dsp_block_mean(const uint16_t *samples, uint32_t n);
+uint32_t mic_dsp_block_rms(const uint16_t *samples, uint32_t n, int32_t dc, uint16_t *peak);
+bool mic_dsp_process_block(mic_dsp_t *dsp, const uint16_t *samples, uint32_t n);
+
+#endif
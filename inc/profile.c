@@ -0,0 +1,105 @@
+#include "profile.h"
+
+#if PROFILE_ENABLED
+
+#include "hardware/structs/systick.h"
+#include "hardware/clocks.h"
+#include <stdio.h>
+
+#define SYSTICK_MASK 0xFFFFFFu  // Contador decrescente de 24 bits
+
+typedef struct {
+  uint32_t start;
+  uint32_t count;
+  uint32_t min, max;
+  uint64_t total;
+  uint32_t buckets[PROFILE_BUCKETS];
+} profile_stats_t;
+
+static const char *const stage_names[PROFILE_STAGES] = {
+    "adc", "joystick", "logic", "render", "bus", "led"
+};
+
+static profile_stats_t stats[PROFILE_STAGES];
+static volatile uint32_t overruns = 0;
+
+// Liga o SysTick do core que chamar, contando no clock do processador
+void profile_init_core(void) {
+    systick_hw->rvr = SYSTICK_MASK;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+}
+
+void profile_start(profile_stage_t stage) {
+    stats[stage].start = systick_hw->cvr;
+}
+
+static inline uint32_t profile_bucket(uint32_t cycles) {
+    if (cycles < 64) return 0;
+    uint32_t b = 31 - __builtin_clz(cycles) - 5;
+    return b < PROFILE_BUCKETS ? b : PROFILE_BUCKETS - 1;
+}
+
+void profile_stop(profile_stage_t stage) {
+    profile_stats_t *s = &stats[stage];
+    uint32_t cycles = (s->start - systick_hw->cvr) & SYSTICK_MASK;
+    if (s->count == 0 || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->total += cycles;
+    s->buckets[profile_bucket(cycles)]++;
+    s->count++;
+}
+
+void profile_overrun(void) {
+    overruns++;
+}
+
+// Limite superior (em ciclos) do bucket onde cai o percentil pedido
+static uint32_t profile_percentile(const profile_stats_t *s, uint32_t pct) {
+    uint32_t target = (uint64_t)s->count * pct / 100;
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < PROFILE_BUCKETS; ++b) {
+        seen += s->buckets[b];
+        if (seen > target) return 1u << (b + 6);
+    }
+    return s->max;
+}
+
+// Relatório compacto: uma linha por estágio, tempos em microssegundos e a
+// média também em ciclos, para estágios abaixo de 1 µs
+void profile_report(void) {
+    uint32_t mhz = clock_get_hz(clk_sys) / 1000000;
+    printf("# estagio n min_us media_us p50_us p99_us max_us media_ciclos | buckets\n");
+    for (int i = 0; i < PROFILE_STAGES; ++i) {
+        const profile_stats_t *s = &stats[i];
+        if (s->count == 0) {
+            printf("%s 0\n", stage_names[i]);
+            continue;
+        }
+        printf("%s %lu %lu %lu %lu %lu %lu %lu |", stage_names[i], (unsigned long)s->count,
+               (unsigned long)(s->min / mhz), (unsigned long)(s->total / s->count / mhz),
+               (unsigned long)(profile_percentile(s, 50) / mhz),
+               (unsigned long)(profile_percentile(s, 99) / mhz),
+               (unsigned long)(s->max / mhz), (unsigned long)(s->total / s->count));
+        for (int b = 0; b < PROFILE_BUCKETS; ++b)
+            printf(" %lu", (unsigned long)s->buckets[b]);
+        printf("\n");
+    }
+    printf("overruns %lu\n", (unsigned long)overruns);
+}
+
+void profile_reset(void) {
+    for (int i = 0; i < PROFILE_STAGES; ++i)
+        stats[i] = (profile_stats_t){0};
+    overruns = 0;
+}
+
+// Comandos pela USB CDC: 'p' imprime o relatório, 'r' zera os contadores
+void profile_command(int c) {
+    if (c == 'p')
+        profile_report();
+    else if (c == 'r')
+        profile_reset();
+}
+
+#endif
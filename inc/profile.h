@@ -0,0 +1,53 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "pico/stdlib.h"
+
+// Perfilamento por estágio do tick com histogramas de ciclos.
+// Ative com -DPROFILE=ON no CMake (define PROFILE_ENABLED=1); desativado, as
+// macros não geram código. Cada estágio é medido sempre no mesmo core, com o
+// SysTick daquele core, então os contadores têm um único escritor.
+
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+#define PROFILE_BUCKETS 20  // Bucket 0: < 64 ciclos; bucket b: [2^(b+5), 2^(b+6))
+
+typedef enum {
+  PROFILE_ADC,      // read_joystick (core0)
+  PROFILE_JOYSTICK, // Só joystick_update: filtro e tabelas (core0)
+  PROFILE_LOGIC,    // Processamento dos eventos, inclui ADC (core0)
+  PROFILE_RENDER,   // Desenho do quadro (core de renderização)
+  PROFILE_BUS,      // Flush até o último byte entrar no FIFO do I2C
+  PROFILE_LED,      // update_led_matrix
+  PROFILE_STAGES
+} profile_stage_t;
+
+#if PROFILE_ENABLED
+
+void profile_init_core(void);
+void profile_start(profile_stage_t stage);
+void profile_stop(profile_stage_t stage);
+void profile_overrun(void);
+void profile_report(void);
+void profile_reset(void);
+void profile_command(int c);
+
+#define PROFILE_INIT_CORE() profile_init_core()
+#define PROFILE_START(stage) profile_start(stage)
+#define PROFILE_STOP(stage) profile_stop(stage)
+#define PROFILE_OVERRUN() profile_overrun()
+#define PROFILE_COMMAND(c) profile_command(c)
+
+#else
+
+#define PROFILE_INIT_CORE() ((void)0)
+#define PROFILE_START(stage) ((void)0)
+#define PROFILE_STOP(stage) ((void)0)
+#define PROFILE_OVERRUN() ((void)0)
+#define PROFILE_COMMAND(c) ((void)(c))
+
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+#include "render_sched.h"
+
+void rate_counter_init(rate_counter_t *rc, uint32_t now_us) {
+    rc->window_start_us = now_us;
+    rc->count = 0;
+    rc->rate = 0;
+}
+
+// Fecha a janela quando ela passa de RATE_WINDOW_US; a taxa é normalizada
+// pela duração real, que pode ser maior se os eventos pararem de chegar
+void rate_counter_add(rate_counter_t *rc, uint32_t now_us) {
+    uint32_t elapsed = now_us - rc->window_start_us;
+    if (elapsed >= RATE_WINDOW_US) {
+        rc->rate = (uint32_t)(((uint64_t)rc->count * 1000000u + elapsed / 2) / elapsed);
+        rc->count = 0;
+        rc->window_start_us = now_us;
+    }
+    rc->count++;
+}
+
+// Sem eventos por mais de uma janela, a última taxa fechada não vale mais
+uint32_t rate_counter_get(const rate_counter_t *rc, uint32_t now_us) {
+    uint32_t elapsed = now_us - rc->window_start_us;
+    if (elapsed < 2 * RATE_WINDOW_US)
+        return rc->rate;
+    return (uint32_t)((uint64_t)rc->count * 1000000u / elapsed);
+}
+
+void render_sched_init(render_sched_t *sched, uint32_t min_interval_us, uint32_t now_us) {
+    sched->min_interval_us = min_interval_us;
+    sched->flush_avg_us = 0;
+    sched->flush_start_us = now_us;
+    sched->last_frame_us = now_us - min_interval_us;
+    sched->pending = false;
+    sched->in_flight = false;
+    sched->frames = 0;
+    sched->skipped = 0;
+    rate_counter_init(&sched->fps, now_us);
+}
+
+void render_sched_mark_dirty(render_sched_t *sched) {
+    sched->pending = true;
+}
+
+// Intervalo entre quadros: o maior entre o mínimo e o flush médio
+uint32_t render_sched_interval(const render_sched_t *sched) {
+    return sched->flush_avg_us > sched->min_interval_us ? sched->flush_avg_us : sched->min_interval_us;
+}
+
+bool render_sched_due(const render_sched_t *sched, uint32_t now_us, bool busy) {
+    if (!sched->pending || busy) return false;
+    return now_us - sched->last_frame_us >= render_sched_interval(sched);
+}
+
+// Chamada antes de iniciar o flush: a IRQ de conclusão pode chegar antes de
+// render_sched_sent
+void render_sched_begin(render_sched_t *sched, uint32_t now_us) {
+    sched->pending = false;
+    sched->last_frame_us = now_us;
+    sched->flush_start_us = now_us;
+    sched->in_flight = true;
+}
+
+// Resultado do flush: zero bytes significa que o quadro não mudou nada na
+// tela e nenhuma conclusão será sinalizada
+void render_sched_sent(render_sched_t *sched, uint32_t now_us, uint32_t bytes) {
+    if (bytes == 0) {
+        sched->in_flight = false;
+        sched->skipped++;
+        return;
+    }
+    sched->frames++;
+    rate_counter_add(&sched->fps, now_us);
+}
+
+void render_sched_flush_done(render_sched_t *sched, uint32_t now_us) {
+    if (!sched->in_flight) return;
+    sched->in_flight = false;
+
+    uint32_t duration = now_us - sched->flush_start_us;
+    if (sched->flush_avg_us == 0) {
+        sched->flush_avg_us = duration;  // Primeira medida
+        return;
+    }
+    int32_t delta = (int32_t)duration - (int32_t)sched->flush_avg_us;
+    sched->flush_avg_us += delta >> RENDER_SCHED_FLUSH_SHIFT;
+}
@@ -0,0 +1,48 @@
+#ifndef RENDER_SCHED_H
+#define RENDER_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Escalonador de quadros do display, separado do tick de entrada.
+// Um quadro só é desenhado quando algo visível mudou, o flush anterior já
+// terminou e passou o intervalo mínimo; o intervalo acompanha a média do
+// tempo de flush medido, então a taxa de quadros se ajusta ao barramento.
+// Não depende do SDK: os tempos chegam como parâmetro.
+
+#define RATE_WINDOW_US 1000000u        // Janela dos contadores de taxa
+#define RENDER_SCHED_MIN_INTERVAL_US 4000u  // Teto de 250 quadros/s
+#define RENDER_SCHED_FLUSH_SHIFT 3     // Média móvel do flush com peso 1/8
+
+// Eventos por segundo, medidos na última janela completa
+typedef struct {
+  uint32_t window_start_us;
+  uint32_t count;
+  uint32_t rate;
+} rate_counter_t;
+
+typedef struct {
+  uint32_t min_interval_us;
+  uint32_t flush_avg_us;    // Média móvel do tempo de flush
+  uint32_t flush_start_us;
+  uint32_t last_frame_us;
+  bool pending;             // Mudança visível ainda não desenhada
+  bool in_flight;           // Flush iniciado e ainda sem conclusão
+  uint32_t frames;          // Quadros enviados ao display
+  uint32_t skipped;         // Quadros sem nenhum byte alterado
+  rate_counter_t fps;
+} render_sched_t;
+
+void rate_counter_init(rate_counter_t *rc, uint32_t now_us);
+void rate_counter_add(rate_counter_t *rc, uint32_t now_us);
+uint32_t rate_counter_get(const rate_counter_t *rc, uint32_t now_us);
+
+void render_sched_init(render_sched_t *sched, uint32_t min_interval_us, uint32_t now_us);
+void render_sched_mark_dirty(render_sched_t *sched);
+bool render_sched_due(const render_sched_t *sched, uint32_t now_us, bool busy);
+uint32_t render_sched_interval(const render_sched_t *sched);
+void render_sched_begin(render_sched_t *sched, uint32_t now_us);
+void render_sched_sent(render_sched_t *sched, uint32_t now_us, uint32_t bytes);
+void render_sched_flush_done(render_sched_t *sched, uint32_t now_us);
+
+#endif
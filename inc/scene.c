@@ -0,0 +1,227 @@
+#include "scene.h"
+#include <string.h>
+
+static inline bool scene_rect_empty(const scene_rect_t *r) {
+    return r->x0 > r->x1 || r->y0 > r->y1;
+}
+
+static inline bool scene_rect_overlaps(const scene_rect_t *a, const scene_rect_t *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static inline void scene_rect_union(scene_rect_t *a, const scene_rect_t *b) {
+    if (b->x0 < a->x0) a->x0 = b->x0;
+    if (b->y0 < a->y0) a->y0 = b->y0;
+    if (b->x1 > a->x1) a->x1 = b->x1;
+    if (b->y1 > a->y1) a->y1 = b->y1;
+}
+
+// Largura em pixels de um número em decimal (8 por dígito)
+static uint8_t scene_number_width(uint32_t value) {
+    uint8_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        digits++;
+    }
+    return digits * 8;
+}
+
+// Recalcula a área do objeto na tela
+static void scene_update_bounds(scene_node_t *node) {
+    int16_t w, h;
+    int16_t min = 0, max_x = SSD1306_WIDTH - 1, max_y = SSD1306_HEIGHT - 1;
+    switch (node->type) {
+        case SCENE_LABEL:
+            w = 8 * (int16_t)strlen(node->text);
+            h = 8;
+            break;
+        case SCENE_NUMBER:
+            w = scene_number_width(node->value);
+            h = 8;
+            break;
+        default:
+            w = node->w;
+            h = node->h;
+            min = SCENE_SPRITE_MARGIN;
+            max_x -= SCENE_SPRITE_MARGIN;
+            max_y -= SCENE_SPRITE_MARGIN;
+            break;
+    }
+
+    scene_rect_t *r = &node->bounds;
+    r->x0 = node->x < min ? min : node->x;
+    r->y0 = node->y < min ? min : node->y;
+    r->x1 = node->x + w - 1 > max_x ? max_x : node->x + w - 1;
+    r->y1 = node->y + h - 1 > max_y ? max_y : node->y + h - 1;
+    if (!node->visible || w == 0) r->x1 = r->x0 - 1;
+}
+
+// Acrescenta uma área danificada, juntando com outra que ela cruze
+static void scene_damage(scene_t *scene, const scene_rect_t *rect) {
+    if (scene_rect_empty(rect)) return;
+    for (uint8_t i = 0; i < scene->damage_count; ++i) {
+        if (scene_rect_overlaps(&scene->damage[i], rect)) {
+            scene_rect_union(&scene->damage[i], rect);
+            return;
+        }
+    }
+    if (scene->damage_count == SCENE_MAX_DAMAGE) {
+        for (uint8_t i = 1; i < scene->damage_count; ++i)
+            scene_rect_union(&scene->damage[0], &scene->damage[i]);
+        scene_rect_union(&scene->damage[0], rect);
+        scene->damage_count = 1;
+        return;
+    }
+    scene->damage[scene->damage_count++] = *rect;
+}
+
+void scene_init(scene_t *scene) {
+    scene->count = 0;
+    scene_invalidate(scene);
+}
+
+static int scene_add(scene_t *scene, uint8_t type, int16_t x, int16_t y) {
+    if (scene->count == SCENE_MAX_NODES) return -1;
+    scene_node_t *node = &scene->nodes[scene->count];
+    memset(node, 0, sizeof(*node));
+    node->type = type;
+    node->visible = true;
+    node->x = x;
+    node->y = y;
+    return scene->count++;
+}
+
+int scene_add_label(scene_t *scene, int16_t x, int16_t y, const char *text) {
+    int id = scene_add(scene, SCENE_LABEL, x, y);
+    if (id < 0) return id;
+    scene->nodes[id].text = text;
+    scene_update_bounds(&scene->nodes[id]);
+    scene_damage(scene, &scene->nodes[id].bounds);
+    return id;
+}
+
+int scene_add_number(scene_t *scene, int16_t x, int16_t y, uint32_t value) {
+    int id = scene_add(scene, SCENE_NUMBER, x, y);
+    if (id < 0) return id;
+    scene->nodes[id].value = value;
+    scene_update_bounds(&scene->nodes[id]);
+    scene_damage(scene, &scene->nodes[id].bounds);
+    return id;
+}
+
+int scene_add_sprite(scene_t *scene, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bitmap) {
+    int id = scene_add(scene, SCENE_SPRITE, x, y);
+    if (id < 0) return id;
+    scene->nodes[id].w = w;
+    scene->nodes[id].h = h;
+    scene->nodes[id].bitmap = bitmap;
+    scene_update_bounds(&scene->nodes[id]);
+    scene_damage(scene, &scene->nodes[id].bounds);
+    return id;
+}
+
+// Danifica a área antiga e a nova de um objeto que mudou
+static void scene_changed(scene_t *scene, scene_node_t *node) {
+    scene_rect_t old = node->bounds;
+    scene_update_bounds(node);
+    scene_damage(scene, &old);
+    scene_damage(scene, &node->bounds);
+}
+
+void scene_set_text(scene_t *scene, int id, const char *text) {
+    scene_node_t *node = &scene->nodes[id];
+    if (node->text == text) return;
+    node->text = text;
+    scene_changed(scene, node);
+}
+
+void scene_set_number(scene_t *scene, int id, uint32_t value) {
+    scene_node_t *node = &scene->nodes[id];
+    if (node->value == value) return;
+    node->value = value;
+    scene_changed(scene, node);
+}
+
+void scene_move(scene_t *scene, int id, int16_t x, int16_t y) {
+    scene_node_t *node = &scene->nodes[id];
+    if (node->x == x && node->y == y) return;
+    node->x = x;
+    node->y = y;
+    scene_changed(scene, node);
+}
+
+void scene_set_visible(scene_t *scene, int id, bool visible) {
+    scene_node_t *node = &scene->nodes[id];
+    if (node->visible == visible) return;
+    node->visible = visible;
+    scene_changed(scene, node);
+}
+
+// Tela inteira danificada (depois de outra tela ter usado o framebuffer)
+void scene_invalidate(scene_t *scene) {
+    scene->damage[0] = (scene_rect_t){0, 0, SSD1306_WIDTH - 1, SSD1306_HEIGHT - 1};
+    scene->damage_count = 1;
+}
+
+bool scene_damaged(const scene_t *scene) {
+    return scene->damage_count > 0;
+}
+
+static void scene_draw_node(const scene_node_t *node, ssd1306_t *ssd) {
+    switch (node->type) {
+        case SCENE_LABEL: {
+            int16_t x = node->x;
+            for (const char *c = node->text; *c && x < SSD1306_WIDTH; ++c, x += 8)
+                ssd1306_draw_char(ssd, *c, x, node->y);
+            break;
+        }
+        case SCENE_NUMBER:
+            ssd1306_draw_uint(ssd, node->value, node->x, node->y);
+            break;
+        case SCENE_SPRITE:
+            for (int16_t i = 0; i < node->w; ++i) {
+                for (int16_t j = 0; j < node->h; ++j) {
+                    int16_t x = node->x + i;
+                    int16_t y = node->y + j;
+                    if ((node->bitmap[i] >> j & 1) && x >= node->bounds.x0 && x <= node->bounds.x1 &&
+                        y >= node->bounds.y0 && y <= node->bounds.y1)
+                        ssd1306_pixel(ssd, x, y, true);
+                }
+            }
+            break;
+    }
+}
+
+// Redesenha as áreas danificadas. Primeiro fecha o conjunto: todo objeto que
+// cruza uma área danificada vai ser redesenhado, então a área dele também é.
+void scene_render(scene_t *scene, ssd1306_t *ssd) {
+    if (scene->damage_count == 0) return;
+
+    bool redraw[SCENE_MAX_NODES] = {false};
+    bool grew = true;
+    while (grew) {
+        grew = false;
+        for (uint8_t n = 0; n < scene->count; ++n) {
+            const scene_rect_t *bounds = &scene->nodes[n].bounds;
+            if (redraw[n] || scene_rect_empty(bounds)) continue;
+            for (uint8_t d = 0; d < scene->damage_count; ++d) {
+                if (scene_rect_overlaps(bounds, &scene->damage[d])) {
+                    redraw[n] = true;
+                    scene_damage(scene, bounds);
+                    grew = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    for (uint8_t d = 0; d < scene->damage_count; ++d) {
+        const scene_rect_t *r = &scene->damage[d];
+        ssd1306_rect(ssd, r->y0, r->x0, r->x1 - r->x0 + 1, r->y1 - r->y0 + 1, false, true);
+    }
+    for (uint8_t n = 0; n < scene->count; ++n) {
+        if (redraw[n])
+            scene_draw_node(&scene->nodes[n], ssd);
+    }
+    scene->damage_count = 0;
+}
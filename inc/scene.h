@@ -0,0 +1,62 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Camada retida sobre o framebuffer: textos, números e sprites são objetos
+// com retângulo envolvente. Mudar uma propriedade marca como danificados o
+// retângulo antigo e o novo; scene_render limpa e redesenha só as áreas
+// danificadas. Um objeto que cruza uma área danificada é redesenhado inteiro,
+// e a área dele passa a ser danificada também, então objetos sobrepostos
+// saem iguais a um redesenho completo, na ordem em que foram criados.
+
+#define SCENE_MAX_NODES 8
+#define SCENE_MAX_DAMAGE 8         // Acima disso as áreas viram uma só
+#define SCENE_SPRITE_MARGIN 1      // Sprites não tocam a borda da tela
+
+typedef enum {
+  SCENE_LABEL,   // Texto de uma linha (fonte 8x8)
+  SCENE_NUMBER,  // Inteiro sem sinal em decimal
+  SCENE_SPRITE   // Bitmap de até 8x8, colunas como na fonte; bits 0 transparentes
+} scene_node_type_t;
+
+// Retângulo inclusivo em pixels; vazio quando x0 > x1
+typedef struct {
+  int16_t x0, y0, x1, y1;
+} scene_rect_t;
+
+typedef struct {
+  uint8_t type;
+  bool visible;
+  int16_t x, y;           // Canto superior esquerdo
+  uint8_t w, h;           // Só para sprites
+  const char *text;
+  uint32_t value;
+  const uint8_t *bitmap;
+  scene_rect_t bounds;    // Área ocupada na tela (recortada)
+} scene_node_t;
+
+typedef struct {
+  scene_node_t nodes[SCENE_MAX_NODES];
+  uint8_t count;
+  scene_rect_t damage[SCENE_MAX_DAMAGE];
+  uint8_t damage_count;
+} scene_t;
+
+void scene_init(scene_t *scene);
+int scene_add_label(scene_t *scene, int16_t x, int16_t y, const char *text);
+int scene_add_number(scene_t *scene, int16_t x, int16_t y, uint32_t value);
+int scene_add_sprite(scene_t *scene, int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t *bitmap);
+
+void scene_set_text(scene_t *scene, int id, const char *text);
+void scene_set_number(scene_t *scene, int id, uint32_t value);
+void scene_move(scene_t *scene, int id, int16_t x, int16_t y);
+void scene_set_visible(scene_t *scene, int id, bool visible);
+
+void scene_invalidate(scene_t *scene);
+bool scene_damaged(const scene_t *scene);
+void scene_render(scene_t *scene, ssd1306_t *ssd);
+
+#endif
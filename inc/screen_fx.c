@@ -0,0 +1,64 @@
+#include "screen_fx.h"
+
+void screen_fx_init(screen_fx_t *fx) {
+    fx->kind = SCREEN_FX_NONE;
+    fx->step = 0;
+    fx->next_us = 0;
+}
+
+// Número de passos do efeito; depois dele a tela fica parada
+static uint8_t screen_fx_steps(const screen_fx_t *fx) {
+    if (fx->kind == SCREEN_FX_VICTORY) return SCREEN_FX_BLINKS;
+    if (fx->kind == SCREEN_FX_GAME_OVER) return SCREEN_FX_FADE_STEPS;
+    return 0;
+}
+
+// Deve ser chamado com a tela final já entregue ao display: o scroll só
+// pode começar depois da última escrita na RAM dele
+void screen_fx_start(screen_fx_t *fx, ssd1306_t *ssd, screen_fx_kind_t kind, uint32_t now_us) {
+    screen_fx_stop(fx, ssd);
+    fx->kind = kind;
+    fx->step = 0;
+    fx->next_us = now_us + SCREEN_FX_STEP_US;
+
+    if (kind == SCREEN_FX_VICTORY) {
+        ssd1306_scroll(ssd, true, SCREEN_FX_SCROLL_PAGE, SSD1306_PAGES - 1, SSD1306_SCROLL_3_FRAMES);
+        ssd1306_invert(ssd, true);
+    }
+}
+
+// Desfaz o efeito; parar o scroll força o envio do próximo quadro inteiro
+void screen_fx_stop(screen_fx_t *fx, ssd1306_t *ssd) {
+    if (fx->kind == SCREEN_FX_VICTORY) {
+        ssd1306_scroll_stop(ssd);
+        if (!(fx->step & 1))  // Ainda invertida
+            ssd1306_invert(ssd, false);
+    } else if (fx->kind == SCREEN_FX_GAME_OVER && fx->step > 0) {
+        ssd1306_contrast(ssd, 0xFF);
+    }
+    fx->kind = SCREEN_FX_NONE;
+}
+
+// Executa o passo vencido, se houver; retorna true se algo foi enviado
+bool screen_fx_poll(screen_fx_t *fx, ssd1306_t *ssd, uint32_t now_us) {
+    if (fx->step >= screen_fx_steps(fx)) return false;
+    if ((int32_t)(now_us - fx->next_us) < 0) return false;
+
+    fx->step++;
+    fx->next_us += SCREEN_FX_STEP_US;
+    if (fx->kind == SCREEN_FX_VICTORY) {
+        // Começa invertida: passos ímpares voltam ao normal
+        ssd1306_invert(ssd, !(fx->step & 1));
+    } else {
+        uint32_t drop = (uint32_t)(0xFF - SCREEN_FX_FADE_MIN) * fx->step / SCREEN_FX_FADE_STEPS;
+        ssd1306_contrast(ssd, (uint8_t)(0xFF - drop));
+    }
+    return true;
+}
+
+// Instante do próximo passo, para o core dormir até ele
+bool screen_fx_next(const screen_fx_t *fx, uint32_t *deadline_us) {
+    if (fx->step >= screen_fx_steps(fx)) return false;
+    *deadline_us = fx->next_us;
+    return true;
+}
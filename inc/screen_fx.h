@@ -0,0 +1,43 @@
+#ifndef SCREEN_FX_H
+#define SCREEN_FX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Efeitos das telas finais feitos pelo controlador do display: a tela é
+// enviada uma vez e depois só recebe comandos (inversão, contraste e scroll
+// horizontal), poucos bytes por segundo em vez de quadros inteiros.
+// Vitória: a tela pisca invertendo as cores e a última linha rola.
+// Derrota: o contraste cai aos poucos até quase apagar.
+// Não depende do SDK: os tempos chegam como parâmetro.
+
+#define SCREEN_FX_STEP_US 250000u   // Intervalo entre passos do efeito
+#define SCREEN_FX_BLINKS 7          // Trocas de cor da vitória (ímpar: termina normal)
+#define SCREEN_FX_FADE_STEPS 16     // Passos do esmaecimento da derrota
+#define SCREEN_FX_FADE_MIN 0x08     // Contraste no fim do esmaecimento
+#define SCREEN_FX_SCROLL_PAGE 6     // Primeira página rolada na vitória
+
+typedef enum {
+  SCREEN_FX_NONE,
+  SCREEN_FX_VICTORY,
+  SCREEN_FX_GAME_OVER
+} screen_fx_kind_t;
+
+typedef struct {
+  uint8_t kind;
+  uint8_t step;        // Passos já executados
+  uint32_t next_us;    // Instante do próximo passo
+} screen_fx_t;
+
+void screen_fx_init(screen_fx_t *fx);
+void screen_fx_start(screen_fx_t *fx, ssd1306_t *ssd, screen_fx_kind_t kind, uint32_t now_us);
+void screen_fx_stop(screen_fx_t *fx, ssd1306_t *ssd);
+bool screen_fx_poll(screen_fx_t *fx, ssd1306_t *ssd, uint32_t now_us);
+bool screen_fx_next(const screen_fx_t *fx, uint32_t *deadline_us);
+
+static inline bool screen_fx_active(const screen_fx_t *fx) {
+    return fx->kind != SCREEN_FX_NONE;
+}
+
+#endif
@@ -1,18 +1,29 @@
 #include "ssd1306.h"
 #include "font.h"
+#include <string.h>
 
 #define OFFSET 37  // Offset para as letras minúsculas (a-z)
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
-    ssd->width = width;
-    ssd->height = height;
-    ssd->pages = height / 8U;
+static void ssd1306_stream_done(void *user_data) {
+    ssd1306_t *ssd = user_data;
+    if (ssd->flush_callback)
+        ssd->flush_callback(ssd, ssd->flush_user_data);
+}
+
+void ssd1306_init(ssd1306_t *ssd, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
     ssd->address = address;
     ssd->i2c_port = i2c;
-    ssd->bufsize = ssd->pages * ssd->width + 1;
-    ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
-    ssd->ram_buffer[0] = 0x40;
+    ssd->external_vcc = external_vcc;
+    memset(ssd->ram_buffer, 0, sizeof(ssd->ram_buffer));
+    memset(ssd->front_buffer, 0, sizeof(ssd->front_buffer));
+    ssd->dma_len = 0;
     ssd->port_buffer[0] = 0x80;
+    ssd->full_refresh = true;
+    ssd->flush_bytes = 0;
+    ssd->flush_callback = NULL;
+    ssd->flush_user_data = NULL;
+
+    ssd->stream = hal_i2c_stream_init(i2c);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
@@ -22,12 +33,12 @@ void ssd1306_config(ssd1306_t *ssd) {
     ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
     ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
     ssd1306_command(ssd, SET_MUX_RATIO);
-    ssd1306_command(ssd, HEIGHT - 1);
+    ssd1306_command(ssd, SSD1306_HEIGHT - 1);
     ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
     ssd1306_command(ssd, SET_DISP_OFFSET);
     ssd1306_command(ssd, 0x00);
     ssd1306_command(ssd, SET_COM_PIN_CFG);
-    ssd1306_command(ssd, 0x12);
+    ssd1306_command(ssd, SSD1306_HEIGHT == 64 ? 0x12 : 0x02);
     ssd1306_command(ssd, SET_DISP_CLK_DIV);
     ssd1306_command(ssd, 0x80);
     ssd1306_command(ssd, SET_PRECHARGE);
@@ -44,8 +55,9 @@ void ssd1306_config(ssd1306_t *ssd) {
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+    ssd1306_wait_flush(ssd);
     ssd->port_buffer[1] = command;
-    i2c_write_blocking(
+    hal_i2c_write_blocking(
         ssd->i2c_port,
         ssd->address,
         ssd->port_buffer,
@@ -54,24 +66,174 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
     );
 }
 
+// Vários comandos numa única transação (um byte de controle só)
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+    uint8_t buffer[SSD1306_MAX_COMMANDS + 1];
+    if (count > SSD1306_MAX_COMMANDS) count = SSD1306_MAX_COMMANDS;
+    buffer[0] = 0x00;
+    memcpy(&buffer[1], commands, count);
+
+    ssd1306_wait_flush(ssd);
+    hal_i2c_write_blocking(ssd->i2c_port, ssd->address, buffer, count + 1, false);
+}
+
+// Inicia uma nova transação I2C no fluxo do DMA. Transações seguintes à
+// primeira usam RESTART, então todas as janelas saem numa única rajada.
+static inline void ssd1306_dma_begin(ssd1306_t *ssd, uint8_t control) {
+    uint16_t word = control;
+    if (ssd->dma_len > 0) word |= HAL_I2C_RESTART;
+    ssd->dma_buffer[ssd->dma_len++] = word;
+}
+
+// Enfileira uma janela retangular (colunas x0..x1, páginas p0..p1) do buffer.
+// No modo de endereçamento vertical o display percorre as páginas de cada
+// coluna antes de avançar para a próxima, igual ao layout do ram_buffer.
+static void ssd1306_queue_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    ssd1306_dma_begin(ssd, 0x00);
+    ssd->dma_buffer[ssd->dma_len++] = SET_COL_ADDR;
+    ssd->dma_buffer[ssd->dma_len++] = x0;
+    ssd->dma_buffer[ssd->dma_len++] = x1;
+    ssd->dma_buffer[ssd->dma_len++] = SET_PAGE_ADDR;
+    ssd->dma_buffer[ssd->dma_len++] = p0;
+    ssd->dma_buffer[ssd->dma_len++] = p1;
+
+    ssd1306_dma_begin(ssd, 0x40);
+    for (uint8_t x = x0; x <= x1; ++x) {
+        uint16_t base = SSD1306_INDEX(x, 0);
+        for (uint8_t p = p0; p <= p1; ++p) {
+            ssd->dma_buffer[ssd->dma_len++] = ssd->ram_buffer[base + p];
+            ssd->front_buffer[base + p] = ssd->ram_buffer[base + p];
+        }
+    }
+}
+
+// Indica se ainda há um flush em andamento (DMA ou FIFO do I2C esvaziando)
+bool ssd1306_flush_busy(ssd1306_t *ssd) {
+    return hal_i2c_stream_busy(ssd->stream, ssd->i2c_port);
+}
+
+void ssd1306_wait_flush(ssd1306_t *ssd) {
+    while (ssd1306_flush_busy(ssd))
+        tight_loop_contents();
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_callback_t callback, void *user_data) {
+    ssd->flush_callback = callback;
+    ssd->flush_user_data = user_data;
+    hal_i2c_stream_set_callback(ssd->stream, callback ? ssd1306_stream_done : NULL, ssd);
+}
+
+// Monta as regiões que mudaram desde o último flush e as envia por DMA.
+// Retorna false sem fazer nada se o flush anterior ainda não terminou; o
+// quadro atual é então mesclado ao próximo. O ram_buffer pode ser redesenhado
+// assim que a função retorna, pois o DMA lê apenas o dma_buffer.
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+    if (ssd1306_flush_busy(ssd)) return false;
+
+    // Um NACK no flush anterior deixa o display num estado desconhecido
+    if (hal_i2c_take_abort(ssd->i2c_port))
+        ssd->full_refresh = true;
+
+    uint8_t first[8], last[8];
+    uint8_t p_min = 0xFF, p_max = 0;
+    uint8_t x_min = 0xFF, x_max = 0;
+    size_t page_cost = 0;
+
+    // Descobre, por página, o intervalo de colunas alterado
+    for (uint8_t p = 0; p < SSD1306_PAGES; ++p) {
+        first[p] = 0xFF;
+        last[p] = 0;
+        for (uint8_t x = 0; x < SSD1306_WIDTH; ++x) {
+            uint16_t index = SSD1306_INDEX(x, p);
+            if (ssd->full_refresh || ssd->ram_buffer[index] != ssd->front_buffer[index]) {
+                if (first[p] == 0xFF) first[p] = x;
+                last[p] = x;
+            }
+        }
+        if (first[p] == 0xFF) continue;
+
+        if (p < p_min) p_min = p;
+        p_max = p;
+        if (first[p] < x_min) x_min = first[p];
+        if (last[p] > x_max) x_max = last[p];
+        page_cost += SSD1306_WINDOW_OVERHEAD + (last[p] - first[p] + 1);
+    }
+
+    ssd->dma_len = 0;
+    ssd->flush_bytes = 0;
+    ssd->full_refresh = false;
+    if (p_min == 0xFF) return true;  // Nada mudou
+
+    // Uma única janela envolvente pode sair mais barata que várias por página
+    size_t box_cost = SSD1306_WINDOW_OVERHEAD + (size_t)(x_max - x_min + 1) * (p_max - p_min + 1);
+    if (box_cost <= page_cost) {
+        ssd1306_queue_window(ssd, x_min, x_max, p_min, p_max);
+    } else {
+        for (uint8_t p = p_min; p <= p_max; ++p) {
+            if (first[p] != 0xFF)
+                ssd1306_queue_window(ssd, first[p], last[p], p, p);
+        }
+    }
+    ssd->dma_buffer[ssd->dma_len - 1] |= HAL_I2C_STOP;
+    ssd->flush_bytes = ssd->dma_len;
+
+    hal_i2c_stream_start(ssd->stream, ssd->i2c_port, ssd->address, ssd->dma_buffer, ssd->dma_len);
+    return true;
+}
+
+// Versão bloqueante: envia as regiões alteradas e espera o barramento liberar
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, SET_COL_ADDR);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, SET_PAGE_ADDR);
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
-        ssd->i2c_port,
-        ssd->address,
-        ssd->ram_buffer,
-        ssd->bufsize,
-        false
-    );
+    ssd1306_wait_flush(ssd);
+    ssd1306_send_data_async(ssd);
+    ssd1306_wait_flush(ssd);
+}
+
+// Descarta o estado conhecido do display e força o envio completo
+void ssd1306_invalidate(ssd1306_t *ssd) {
+    ssd->full_refresh = true;
+}
+
+size_t ssd1306_flush_bytes(const ssd1306_t *ssd) {
+    return ssd->flush_bytes;
+}
+
+// Inverte a tela inteira (pixels apagados acendem) sem mexer na RAM
+void ssd1306_invert(ssd1306_t *ssd, bool invert) {
+    ssd1306_command(ssd, SET_NORM_INV | (invert ? 0x01 : 0x00));
+}
+
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t contrast) {
+    const uint8_t commands[] = {SET_CONTRAST, contrast};
+    ssd1306_commands(ssd, commands, sizeof(commands));
+}
+
+// Desliga só o painel; a RAM do display é mantida
+void ssd1306_power(ssd1306_t *ssd, bool on) {
+    ssd1306_command(ssd, SET_DISP | (on ? 0x01 : 0x00));
+}
+
+// Scroll horizontal contínuo das páginas p0..p1, feito pelo controlador.
+// Enquanto ele estiver ativo a RAM do display não deve ser escrita.
+void ssd1306_scroll(ssd1306_t *ssd, bool left, uint8_t p0, uint8_t p1, ssd1306_scroll_speed_t speed) {
+    const uint8_t commands[] = {
+        SET_SCROLL_STOP,
+        left ? SET_SCROLL_LEFT : SET_SCROLL_RIGHT,
+        0x00, p0, speed, p1, 0x00, 0xFF,
+        SET_SCROLL_START,
+    };
+    _Static_assert(sizeof(commands) <= SSD1306_MAX_COMMANDS, "scroll não cabe numa transação");
+    ssd1306_commands(ssd, commands, sizeof(commands));
+}
+
+// Para o scroll. O conteúdo rolado fica na RAM do display, que precisa ser
+// reescrita: o próximo flush envia o quadro inteiro.
+void ssd1306_scroll_stop(ssd1306_t *ssd) {
+    ssd1306_command(ssd, SET_SCROLL_STOP);
+    ssd->full_refresh = true;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-    uint16_t index = (y >> 3) + (x << 3) + 1;
+    uint16_t index = SSD1306_INDEX(x, y >> 3);
     uint8_t pixel = (y & 0b111);
     if (value)
         ssd->ram_buffer[index] |= (1 << pixel);
@@ -79,32 +241,59 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
         ssd->ram_buffer[index] &= ~(1 << pixel);
 }
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+// Aplica uma máscara de bits a um byte do buffer
+static inline void ssd1306_apply_mask(uint8_t *byte, uint8_t mask, bool value) {
+    if (value)
+        *byte |= mask;
+    else
+        *byte &= ~mask;
+}
+
+// Trecho vertical y0..y1 (já recortado) numa coluna. As páginas de uma coluna
+// são bytes consecutivos no buffer, então o trecho vira no máximo duas
+// máscaras de borda e bytes inteiros no meio.
+static void ssd1306_vspan(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+    uint8_t *col = &ssd->ram_buffer[SSD1306_INDEX(x, 0)];
+    uint8_t p0 = y0 >> 3;
+    uint8_t p1 = y1 >> 3;
+    uint8_t first_mask = 0xFF << (y0 & 0b111);
+    uint8_t last_mask = 0xFF >> (7 - (y1 & 0b111));
+
+    if (p0 == p1) {
+        ssd1306_apply_mask(&col[p0], first_mask & last_mask, value);
+        return;
     }
+    ssd1306_apply_mask(&col[p0], first_mask, value);
+    for (uint8_t p = p0 + 1; p < p1; ++p)
+        col[p] = value ? 0xFF : 0x00;
+    ssd1306_apply_mask(&col[p1], last_mask, value);
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+    memset(ssd->ram_buffer, value ? 0xFF : 0x00, SSD1306_FB_SIZE);
 }
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-    for (uint8_t x = left; x < left + width; ++x) {
-        ssd1306_pixel(ssd, x, top, value);
-        ssd1306_pixel(ssd, x, top + height - 1, value);
-    }
-    for (uint8_t y = top; y < top + height; ++y) {
-        ssd1306_pixel(ssd, left, y, value);
-        ssd1306_pixel(ssd, left + width - 1, y, value);
-    }
+    if (width == 0 || height == 0 || left >= SSD1306_WIDTH || top >= SSD1306_HEIGHT) return;
+
+    // Bordas direita e de baixo fora da tela não são desenhadas na última
+    // coluna/linha visível: só o trecho recortado dos outros lados aparece
+    int right = left + width - 1;
+    int bottom = top + height - 1;
+    bool right_visible = right < SSD1306_WIDTH, bottom_visible = bottom < SSD1306_HEIGHT;
+    if (!right_visible) right = SSD1306_WIDTH - 1;
+    if (!bottom_visible) bottom = SSD1306_HEIGHT - 1;
 
     if (fill) {
-        for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-            for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-                ssd1306_pixel(ssd, x, y, value);
-            }
-        }
+        for (int x = left; x <= right; ++x)
+            ssd1306_vspan(ssd, x, top, bottom, value);
+        return;
     }
+
+    ssd1306_hline(ssd, left, right, top, value);
+    if (bottom_visible) ssd1306_hline(ssd, left, right, bottom, value);
+    ssd1306_vspan(ssd, left, top, bottom, value);
+    if (right_visible) ssd1306_vspan(ssd, right, top, bottom, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -135,32 +324,81 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
     }
 }
 
+// Linha horizontal: um bit por coluna, mesmo byte de página a cada SSD1306_PAGES bytes
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-    for (uint8_t x = x0; x <= x1; ++x)
-        ssd1306_pixel(ssd, x, y, value);
+    if (y >= SSD1306_HEIGHT || x0 >= SSD1306_WIDTH) return;
+    if (x1 >= SSD1306_WIDTH) x1 = SSD1306_WIDTH - 1;
+    if (x0 > x1) return;
+
+    uint8_t *byte = &ssd->ram_buffer[SSD1306_INDEX(x0, y >> 3)];
+    uint8_t mask = 1 << (y & 0b111);
+    for (uint8_t x = x0; x <= x1; ++x, byte += SSD1306_PAGES)
+        ssd1306_apply_mask(byte, mask, value);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-    for (uint8_t y = y0; y <= y1; ++y)
-        ssd1306_pixel(ssd, x, y, value);
+    if (x >= SSD1306_WIDTH || y0 >= SSD1306_HEIGHT) return;
+    if (y1 >= SSD1306_HEIGHT) y1 = SSD1306_HEIGHT - 1;
+    if (y0 > y1) return;
+
+    ssd1306_vspan(ssd, x, y0, y1, value);
 }
 
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
-    uint16_t index = 0;
-    if (c >= 'A' && c <= 'Z') {
-        index = (c - 'A' + 11) * 8;
-    } else if (c >= 'a' && c <= 'z') {
-        index = (c - 'a' + OFFSET) * 8;
-    } else if (c >= '0' && c <= '9') {
-        index = (c - '0' + 1) * 8;
+// Índice do glifo na tabela da fonte
+static inline uint16_t ssd1306_glyph_index(char c) {
+    if (c >= 'A' && c <= 'Z') return (c - 'A' + 11) * 8;
+    if (c >= 'a' && c <= 'z') return (c - 'a' + OFFSET) * 8;
+    if (c >= '0' && c <= '9') return (c - '0' + 1) * 8;
+    return 0;
+}
+
+// Copia um glifo 8x8 direto para o buffer. Cada byte da fonte é uma coluna,
+// no mesmo formato de uma página do display: com y alinhado em 8 o byte é
+// copiado inteiro; caso contrário é deslocado e mesclado em duas páginas.
+static void ssd1306_blit_glyph(ssd1306_t *ssd, const uint8_t *glyph, uint8_t x, uint8_t y) {
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+
+    uint8_t cols = (SSD1306_WIDTH - x < 8) ? SSD1306_WIDTH - x : 8;
+    uint8_t page = y >> 3;
+    uint8_t shift = y & 0b111;
+    uint8_t *dst = &ssd->ram_buffer[SSD1306_INDEX(x, page)];
+
+    if (shift == 0) {
+        for (uint8_t i = 0; i < cols; ++i)
+            dst[SSD1306_INDEX(i, 0)] = glyph[i];
+        return;
     }
-    
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-        }
+
+    bool has_next = page + 1 < SSD1306_PAGES;
+    uint8_t low_mask = 0xFF << shift;
+    uint8_t high_mask = 0xFF >> (8 - shift);
+    for (uint8_t i = 0; i < cols; ++i) {
+        uint8_t *col = dst + SSD1306_INDEX(i, 0);
+        col[0] = (col[0] & ~low_mask) | (uint8_t)(glyph[i] << shift);
+        if (has_next)
+            col[1] = (col[1] & ~high_mask) | (glyph[i] >> (8 - shift));
+    }
+}
+
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    ssd1306_blit_glyph(ssd, &font[ssd1306_glyph_index(c)], x, y);
+}
+
+// Desenha um inteiro sem sinal em decimal, sem passar pela formatação da libc.
+// Retorna a coordenada x logo após o último dígito.
+uint8_t ssd1306_draw_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y) {
+    uint8_t digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = value % 10;
+        value /= 10;
+    } while (value);
+
+    while (count-- && x < SSD1306_WIDTH) {
+        ssd1306_blit_glyph(ssd, &font[(digits[count] + 1) * 8], x, y);
+        x += 8;
     }
+    return x;
 }
 
 // Função para desenhar uma string
@@ -168,11 +406,11 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
     while (*str) {
         ssd1306_draw_char(ssd, *str++, x, y);
         x += 8;
-        if (x + 8 >= ssd->width) {
+        if (x + 8 >= SSD1306_WIDTH) {
             x = 0;
             y += 8;
         }
-        if (y + 8 >= ssd->height) {
+        if (y + 8 >= SSD1306_HEIGHT) {
             break;
         }
     }
@@ -1,9 +1,35 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "hal.h"
+
+// Geometria fixa em tempo de compilação (redefinível pelo CMake). Todo o
+// cálculo de índice do buffer vira constante: com 8 páginas, x * PAGES é um
+// deslocamento. Não há alocação dinâmica; os buffers ficam dentro do
+// ssd1306_t, que é declarado estático pela aplicação.
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH 128
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT 64
+#endif
+
+#define SSD1306_PAGES (SSD1306_HEIGHT / 8)
+#define SSD1306_FB_SIZE (SSD1306_WIDTH * SSD1306_PAGES)
+#define SSD1306_WINDOW_OVERHEAD 8  // 7 bytes de comandos + 1 byte de controle dos dados
+#define SSD1306_DMA_WORDS (SSD1306_FB_SIZE + SSD1306_WINDOW_OVERHEAD)  // Pior caso: tela toda
+#define SSD1306_MAX_COMMANDS 12  // Comandos por transação em ssd1306_commands
+
+// Byte da página p na coluna x: as páginas de uma coluna são consecutivas
+// (endereçamento vertical do display)
+#define SSD1306_INDEX(x, p) ((x) * SSD1306_PAGES + (p))
+
+_Static_assert(SSD1306_HEIGHT % 8 == 0, "altura precisa ser múltipla de 8");
+_Static_assert(SSD1306_WIDTH <= 128 && SSD1306_HEIGHT <= 64, "geometria maior que a do SSD1306");
 
-#define WIDTH 128
-#define HEIGHT 64
+#define WIDTH SSD1306_WIDTH
+#define HEIGHT SSD1306_HEIGHT
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -22,22 +48,62 @@ typedef enum {
   SET_DISP_CLK_DIV = 0xD5,
   SET_PRECHARGE = 0xD9,
   SET_VCOM_DESEL = 0xDB,
-  SET_CHARGE_PUMP = 0x8D
+  SET_CHARGE_PUMP = 0x8D,
+  SET_SCROLL_RIGHT = 0x26,
+  SET_SCROLL_LEFT = 0x27,
+  SET_SCROLL_STOP = 0x2E,
+  SET_SCROLL_START = 0x2F
 } ssd1306_command_t;
 
-typedef struct {
-  uint8_t width, height, pages, address;
+// Intervalo do scroll horizontal, em quadros do display por passo de coluna
+typedef enum {
+  SSD1306_SCROLL_2_FRAMES = 0x07,
+  SSD1306_SCROLL_3_FRAMES = 0x04,
+  SSD1306_SCROLL_4_FRAMES = 0x05,
+  SSD1306_SCROLL_5_FRAMES = 0x00,
+  SSD1306_SCROLL_25_FRAMES = 0x06,
+  SSD1306_SCROLL_64_FRAMES = 0x01,
+  SSD1306_SCROLL_128_FRAMES = 0x02,
+  SSD1306_SCROLL_256_FRAMES = 0x03
+} ssd1306_scroll_speed_t;
+
+typedef struct ssd1306 ssd1306_t;
+typedef void (*ssd1306_flush_callback_t)(ssd1306_t *ssd, void *user_data);
+
+struct ssd1306 {
+  uint8_t ram_buffer[SSD1306_FB_SIZE] __attribute__((aligned(4)));    // Buffer de desenho (traseiro)
+  uint8_t front_buffer[SSD1306_FB_SIZE] __attribute__((aligned(4)));  // Quadro já entregue ao display (frontal)
+  uint16_t dma_buffer[SSD1306_DMA_WORDS] __attribute__((aligned(4))); // Palavras IC_DATA_CMD consumidas pelo DMA
+  size_t dma_len;
+  uint8_t address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
-  uint8_t *ram_buffer;
-  size_t bufsize;
+  int stream;               // Fluxo I2C da HAL (canal de DMA no firmware)
+  bool full_refresh;        // Força o envio do quadro inteiro no próximo flush
+  size_t flush_bytes;       // Bytes enviados pelo barramento no último flush
+  ssd1306_flush_callback_t flush_callback;
+  void *flush_user_data;
   uint8_t port_buffer[2];
-} ssd1306_t;
+};
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init(ssd1306_t *ssd, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_flush_busy(ssd1306_t *ssd);
+void ssd1306_wait_flush(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_callback_t callback, void *user_data);
+void ssd1306_invalidate(ssd1306_t *ssd);
+size_t ssd1306_flush_bytes(const ssd1306_t *ssd);
+
+// Efeitos feitos pelo próprio controlador, sem reenviar o framebuffer
+void ssd1306_invert(ssd1306_t *ssd, bool invert);
+void ssd1306_contrast(ssd1306_t *ssd, uint8_t contrast);
+void ssd1306_power(ssd1306_t *ssd, bool on);
+void ssd1306_scroll(ssd1306_t *ssd, bool left, uint8_t p0, uint8_t p1, ssd1306_scroll_speed_t speed);
+void ssd1306_scroll_stop(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -46,4 +112,7 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+uint8_t ssd1306_draw_uint(ssd1306_t *ssd, uint32_t value, uint8_t x, uint8_t y);
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+#endif
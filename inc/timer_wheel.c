@@ -0,0 +1,80 @@
+#include "timer_wheel.h"
+#include <string.h>
+
+_Static_assert((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0, "slots precisam ser potência de 2");
+
+void timer_wheel_init(timer_wheel_t *wheel, uint32_t now_tick) {
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->now = now_tick;
+}
+
+static void timer_wheel_link(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+    timer_wheel_timer_t **slot = &wheel->slots[timer->expires & (TIMER_WHEEL_SLOTS - 1)];
+    timer->prev = NULL;
+    timer->next = *slot;
+    if (*slot) (*slot)->prev = timer;
+    *slot = timer;
+}
+
+static void timer_wheel_unlink(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+    if (timer->prev)
+        timer->prev->next = timer->next;
+    else
+        wheel->slots[timer->expires & (TIMER_WHEEL_SLOTS - 1)] = timer->next;
+    if (timer->next) timer->next->prev = timer->prev;
+}
+
+// Arma (ou rearma) o temporizador para daqui a delay_ticks, no mínimo um
+void timer_wheel_start(timer_wheel_t *wheel, timer_wheel_timer_t *timer, uint32_t delay_ticks,
+                       uint32_t period_ticks, timer_wheel_callback_t callback, void *user_data) {
+    if (timer->armed)
+        timer_wheel_unlink(wheel, timer);
+    else if (++wheel->active > wheel->high_water)
+        wheel->high_water = wheel->active;
+
+    timer->expires = wheel->now + (delay_ticks ? delay_ticks : 1);
+    timer->period = period_ticks;
+    timer->callback = callback;
+    timer->user_data = user_data;
+    timer->armed = true;
+    timer_wheel_link(wheel, timer);
+}
+
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_timer_t *timer) {
+    if (!timer->armed) return;
+    timer_wheel_unlink(wheel, timer);
+    timer->armed = false;
+    wheel->active--;
+}
+
+// Processa os ticks até now_tick. Cada slot guarda também prazos de voltas
+// futuras, que ficam para quando o tick bater.
+void timer_wheel_advance(timer_wheel_t *wheel, uint32_t now_tick) {
+    if ((int32_t)(now_tick - wheel->now) > 1)
+        wheel->late_ticks += now_tick - wheel->now - 1;
+
+    while ((int32_t)(now_tick - wheel->now) > 0) {
+        uint32_t tick = ++wheel->now;
+        timer_wheel_timer_t **slot = &wheel->slots[tick & (TIMER_WHEEL_SLOTS - 1)];
+        timer_wheel_timer_t *timer = *slot;
+        while (timer) {
+            if (timer->expires != tick) {
+                timer = timer->next;
+                continue;
+            }
+            timer_wheel_unlink(wheel, timer);
+            timer->armed = false;
+            wheel->active--;
+            wheel->fired++;
+
+            bool keep = timer->callback(timer, timer->user_data);
+            // O callback pode ter rearmado o próprio temporizador
+            if (keep && timer->period && !timer->armed)
+                timer_wheel_start(wheel, timer, timer->period, timer->period, timer->callback, timer->user_data);
+            // E pode ter cancelado ou movido outros do mesmo slot: o próximo
+            // guardado antes do callback não vale mais, recomeça da cabeça.
+            // Os que já dispararam saíram do slot (rearmados, vencem depois).
+            timer = *slot;
+        }
+    }
+}
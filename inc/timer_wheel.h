@@ -0,0 +1,61 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Roda de temporizadores com resolução de um tick, avançada por um único
+// alarme de hardware. Os temporizadores são estruturas estáticas de quem os
+// usa (listas intrusivas, sem heap): armar e cancelar são O(1) e rearmar um
+// temporizador já armado só o move de posição, então apertar um botão
+// várias vezes não consome mais recursos. Prazos maiores que a roda dão
+// voltas extras no mesmo slot.
+// Não depende do SDK nem faz travamento: quem usa a partir de mais de um
+// contexto (IRQ e outro core) protege as chamadas.
+//
+// Os callbacks rodam dentro de timer_wheel_advance e podem armar e cancelar
+// temporizadores (inclusive outros do mesmo tick) chamando timer_wheel_start
+// e timer_wheel_cancel direto. No firmware o advance roda com o timers_lock
+// de blink.c, que não é recursivo: um callback que chame timers_start ou
+// timers_cancel trava o core.
+
+#define TIMER_WHEEL_TICK_US 1000u  // Resolução
+#define TIMER_WHEEL_SLOTS 256u     // Potência de 2; prazos de até 256 ms num passe
+
+typedef struct timer_wheel_timer timer_wheel_timer_t;
+
+// Retorna true para continuar, se o temporizador for periódico
+typedef bool (*timer_wheel_callback_t)(timer_wheel_timer_t *timer, void *user_data);
+
+struct timer_wheel_timer {
+  timer_wheel_timer_t *next, *prev;  // Lista do slot
+  uint32_t expires;                  // Tick absoluto do disparo
+  uint32_t period;                   // Em ticks; 0 = dispara uma vez
+  timer_wheel_callback_t callback;
+  void *user_data;
+  bool armed;
+};
+
+typedef struct {
+  timer_wheel_timer_t *slots[TIMER_WHEEL_SLOTS];
+  uint32_t now;          // Último tick processado
+  uint16_t active;       // Temporizadores armados
+  uint16_t high_water;   // Máximo de armados ao mesmo tempo
+  uint32_t fired;        // Disparos desde o início
+  uint32_t late_ticks;   // Ticks processados com atraso (alarme atrasado)
+} timer_wheel_t;
+
+void timer_wheel_init(timer_wheel_t *wheel, uint32_t now_tick);
+void timer_wheel_start(timer_wheel_t *wheel, timer_wheel_timer_t *timer, uint32_t delay_ticks,
+                       uint32_t period_ticks, timer_wheel_callback_t callback, void *user_data);
+void timer_wheel_cancel(timer_wheel_t *wheel, timer_wheel_timer_t *timer);
+void timer_wheel_advance(timer_wheel_t *wheel, uint32_t now_tick);
+
+static inline bool timer_wheel_armed(const timer_wheel_timer_t *timer) {
+    return timer->armed;
+}
+
+// Prazo em ms para ticks, arredondado para cima
+#define TIMER_WHEEL_MS(ms) (((ms) * 1000u + TIMER_WHEEL_TICK_US - 1) / TIMER_WHEEL_TICK_US)
+
+#endif
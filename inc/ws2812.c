@@ -0,0 +1,102 @@
+#include "ws2812.h"
+#include "ws2812.pio.h"
+#include "hardware/dma.h"
+#include <string.h>
+
+// Correção gama 2.2 por canal
+static const uint8_t gamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+static PIO ws_pio;
+static uint ws_sm;
+static int dma_chan = -1;
+
+static uint32_t framebuffer[WS2812_NUM_PIXELS];  // Cores lógicas (GRB)
+static uint32_t tx_buffer[WS2812_NUM_PIXELS];    // Palavras lidas pelo DMA
+static uint8_t brightness = 255;
+static bool has_sent = false;
+static uint64_t ready_at_us = 0;  // Fim do quadro anterior + latch
+
+void ws2812_init(PIO pio, uint sm, uint pin) {
+    ws_pio = pio;
+    ws_sm = sm;
+    uint offset = pio_add_program(pio, &ws2812_program);
+    ws2812_program_init(pio, sm, offset, pin, 800000, false);
+
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(dma_chan, &c, &pio->txf[sm], tx_buffer, WS2812_NUM_PIXELS, false);
+}
+
+void ws2812_set_pixel(uint index, uint32_t grb) {
+    if (index < WS2812_NUM_PIXELS)
+        framebuffer[index] = grb;
+}
+
+void ws2812_fill(uint32_t grb) {
+    for (uint i = 0; i < WS2812_NUM_PIXELS; ++i)
+        framebuffer[i] = grb;
+}
+
+// Barra de progresso: os primeiros count LEDs acesos com a cor on
+void ws2812_fill_progress(uint count, uint32_t on, uint32_t off) {
+    for (uint i = 0; i < WS2812_NUM_PIXELS; ++i)
+        framebuffer[i] = i < count ? on : off;
+}
+
+void ws2812_set_brightness(uint8_t level) {
+    brightness = level;
+}
+
+// Aplica brilho e gama a um canal de 8 bits
+static inline uint32_t ws2812_scale(uint32_t channel) {
+    return gamma8[(channel * (brightness + 1u)) >> 8];
+}
+
+// O DMA termina quando o último pixel entra no FIFO; o PIO ainda precisa
+// serializá-lo e a linha precisa ficar em nível baixo pelo tempo de latch
+bool ws2812_busy(void) {
+    return dma_channel_is_busy(dma_chan) || time_us_64() < ready_at_us;
+}
+
+// Envia o framebuffer se ele mudou desde o último envio. Retorna true se um
+// quadro foi iniciado; com o driver ocupado o quadro fica para a próxima chamada.
+bool ws2812_show(void) {
+    uint32_t frame[WS2812_NUM_PIXELS];
+    for (uint i = 0; i < WS2812_NUM_PIXELS; ++i) {
+        uint32_t c = framebuffer[i];
+        uint32_t g = ws2812_scale((c >> 16) & 0xFF);
+        uint32_t r = ws2812_scale((c >> 8) & 0xFF);
+        uint32_t b = ws2812_scale(c & 0xFF);
+        frame[i] = ((g << 16) | (r << 8) | b) << 8u;  // 24 bits alinhados à esquerda
+    }
+
+    if (has_sent && memcmp(frame, tx_buffer, sizeof(frame)) == 0) return false;
+    if (ws2812_busy()) return false;
+
+    memcpy(tx_buffer, frame, sizeof(frame));
+    has_sent = true;
+    ready_at_us = time_us_64() + (WS2812_NUM_PIXELS * 24 * WS2812_BIT_US_X100) / 100 + WS2812_RESET_US;
+    dma_channel_transfer_from_buffer_now(dma_chan, tx_buffer, WS2812_NUM_PIXELS);
+    return true;
+}
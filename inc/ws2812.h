@@ -0,0 +1,28 @@
+#ifndef WS2812_H
+#define WS2812_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Driver da matriz 5x5 de LEDs WS2812 sobre o programa ws2812.pio.
+// Mantém um framebuffer GRB persistente, envia por DMA ao FIFO de TX do PIO
+// e só transmite quando o quadro difere do último enviado.
+
+#define WS2812_NUM_PIXELS 25
+#define WS2812_RESET_US 300    // Tempo em nível baixo para travar o quadro
+#define WS2812_BIT_US_X100 125 // 1,25 us por bit a 800 kHz
+
+// Cor no formato GRB usado pelos LEDs
+static inline uint32_t ws2812_rgb(uint8_t r, uint8_t g, uint8_t b) {
+  return ((uint32_t)g << 16) | ((uint32_t)r << 8) | b;
+}
+
+void ws2812_init(PIO pio, uint sm, uint pin);
+void ws2812_set_pixel(uint index, uint32_t grb);
+void ws2812_fill(uint32_t grb);
+void ws2812_fill_progress(uint count, uint32_t on, uint32_t off);
+void ws2812_set_brightness(uint8_t level);
+bool ws2812_busy(void);
+bool ws2812_show(void);
+
+#endif